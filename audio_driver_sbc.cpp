@@ -54,6 +54,10 @@ Error AudioDriverSBC::init_output_device() {
 	return OK;
 }
 
+void AudioDriverSBC::set_output_latency_ms(int p_msec) {
+	latency = next_power_of_2(uint32_t(MAX(256, p_msec * mix_rate / 1000)));
+}
+
 Error AudioDriverSBC::init() {
 	active = false;
 
@@ -46,6 +46,9 @@ public:
 	virtual String get_output_device() override;
 	virtual void set_output_device(const String &p_name) override;
 
+	// Must be called before init(). Rounded up to a power-of-two buffer.
+	void set_output_latency_ms(int p_msec);
+
 	virtual void lock() override;
 	virtual void unlock() override;
 	virtual void finish() override;
@@ -0,0 +1,210 @@
+#include "device_profile_sbc.h"
+
+#include "core/io/config_file.h"
+#include "core/io/dir_access.h"
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+
+#include <stdio.h>
+
+static const char *CACHE_SECTION = "profile";
+
+String DeviceProfileSBC::_root() {
+	return OS::get_singleton()->get_environment("GODOT_SBC_SYSFS_ROOT");
+}
+
+String DeviceProfileSBC::_read_first_line(const String &p_path) {
+	// sysfs and procfs report a bogus file size, so read them like a stream.
+	FILE *file = fopen(p_path.utf8().get_data(), "r");
+	if (!file) {
+		return String();
+	}
+	char line[256] = {};
+	if (!fgets(line, sizeof(line), file)) {
+		line[0] = '\0';
+	}
+	fclose(file);
+	// The device-tree model is NUL terminated, utf8() stops there.
+	return String::utf8(line).strip_edges();
+}
+
+int DeviceProfileSBC::_count_cpus(const String &p_list, int &r_last) {
+	// Kernel CPU list format, e.g. "0-3" or "0-3,6-7". IDs can have gaps.
+	int count = 0;
+	r_last = -1;
+	for (const String &range : p_list.split(",", false)) {
+		int dash = range.find("-");
+		if (dash < 0) {
+			count++;
+			r_last = MAX(r_last, range.to_int());
+		} else {
+			count += MAX(0, range.substr(dash + 1).to_int() - range.substr(0, dash).to_int() + 1);
+			r_last = MAX(r_last, range.substr(dash + 1).to_int());
+		}
+	}
+	return count;
+}
+
+int DeviceProfileSBC::_read_mem_total_mb(const String &p_path) {
+	FILE *file = fopen(p_path.utf8().get_data(), "r");
+	if (!file) {
+		return 0;
+	}
+	unsigned long kb = 0;
+	char line[256];
+	while (fgets(line, sizeof(line), file)) {
+		if (sscanf(line, "MemTotal: %lu kB", &kb) == 1) {
+			break;
+		}
+	}
+	fclose(file);
+	return int(kb / 1024);
+}
+
+void DeviceProfileSBC::_scan(const String &p_root) {
+	profile.model = _read_first_line(p_root + "/proc/device-tree/model");
+	if (profile.model.is_empty()) {
+		profile.model = "unknown";
+	}
+
+	int last_cpu = -1;
+	profile.cores = _count_cpus(_read_first_line(p_root + "/sys/devices/system/cpu/present"), last_cpu);
+	if (profile.cores == 0 && p_root.is_empty()) {
+		profile.cores = OS::get_singleton()->get_processor_count();
+		last_cpu = profile.cores - 1;
+	}
+
+	// big.LITTLE parts list their clusters separately, the fastest one counts.
+	// CPUs missing from the list have no cpufreq directory and read as 0.
+	profile.max_freq_mhz = 0;
+	for (int i = 0; i <= last_cpu; i++) {
+		int khz = _read_first_line(p_root + vformat("/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", i)).to_int();
+		profile.max_freq_mhz = MAX(profile.max_freq_mhz, khz / 1000);
+	}
+
+	profile.ram_mb = _read_mem_total_mb(p_root + "/proc/meminfo");
+}
+
+const DeviceProfileSBC::Profile &DeviceProfileSBC::probe(const String &p_renderer) {
+	if (probed) {
+		return profile;
+	}
+	probed = true;
+
+	profile.renderer = p_renderer;
+	_scan(_root());
+	return profile;
+}
+
+String DeviceProfileSBC::_cache_path() {
+	// A fake tree is never cached, nor read from the cache.
+	if (!_root().is_empty()) {
+		return String();
+	}
+	return OS::get_singleton()->get_cache_path().path_join("godot_sbc").path_join("device_profile.cfg");
+}
+
+String DeviceProfileSBC::_cache_key(const Array &p_tiers) const {
+	// Everything select_tier() looks at, so a board swap, RAM variant,
+	// overclock, driver change or edited tier table decides again.
+	return vformat("%s|%d|%d|%d|%s|%x", profile.model, profile.cores, profile.max_freq_mhz, profile.ram_mb, profile.renderer, p_tiers.hash());
+}
+
+Dictionary DeviceProfileSBC::select_tier_cached(const Array &p_tiers, bool &r_cached) const {
+	r_cached = false;
+	String path = _cache_path();
+	String key = _cache_key(p_tiers);
+	Ref<ConfigFile> config;
+	config.instantiate();
+	if (!path.is_empty() && config->load(path) == OK && String(config->get_value(CACHE_SECTION, "key", String())) == key) {
+		String name = config->get_value(CACHE_SECTION, "tier", String());
+		for (int i = 0; i < p_tiers.size(); i++) {
+			if (p_tiers[i].get_type() == Variant::DICTIONARY && String(Dictionary(p_tiers[i]).get("name", String())) == name) {
+				r_cached = true;
+				return p_tiers[i];
+			}
+		}
+	}
+
+	Dictionary tier = select_tier(p_tiers);
+	if (path.is_empty() || tier.is_empty()) {
+		return tier;
+	}
+	config->clear();
+	config->set_value(CACHE_SECTION, "key", key);
+	config->set_value(CACHE_SECTION, "tier", tier.get("name", String()));
+	config->set_value(CACHE_SECTION, "profile", to_string());
+	DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+	if (config->save(path) != OK) {
+		print_verbose("Could not save the device profile cache to " + path);
+	}
+	return tier;
+}
+
+Array DeviceProfileSBC::get_default_tiers() {
+	// Ordered from the most demanding tier down; the last one matches anything.
+	// Audio latencies land on 512/1024/2048-frame buffers at 44.1 and 48 kHz.
+	// Physics ticks are left out: changing them alters gameplay, so only a
+	// project's own tier table may set them.
+	Array tiers;
+
+	Dictionary high; // RK3588 class.
+	high["name"] = "high";
+	high["min_cores"] = 8;
+	high["min_freq_mhz"] = 2000;
+	high["min_ram_mb"] = 3500;
+	high["render_scale"] = 1.0;
+	high["msaa"] = 1; // 2x
+	high["shadow_quality"] = 2;
+	high["audio_latency_ms"] = 10;
+	tiers.push_back(high);
+
+	Dictionary medium; // Pi 4 / Pi 5 class.
+	medium["name"] = "medium";
+	medium["min_cores"] = 4;
+	medium["min_freq_mhz"] = 1400;
+	medium["min_ram_mb"] = 1800;
+	medium["render_scale"] = 0.75;
+	medium["msaa"] = 0;
+	medium["shadow_quality"] = 1;
+	medium["audio_latency_ms"] = 20;
+	tiers.push_back(medium);
+
+	Dictionary low; // Pi 3 class and anything unknown.
+	low["name"] = "low";
+	low["render_scale"] = 0.5;
+	low["msaa"] = 0;
+	low["shadow_quality"] = 0;
+	low["audio_latency_ms"] = 40;
+	tiers.push_back(low);
+
+	return tiers;
+}
+
+Dictionary DeviceProfileSBC::select_tier(const Array &p_tiers) const {
+	for (int i = 0; i < p_tiers.size(); i++) {
+		if (p_tiers[i].get_type() != Variant::DICTIONARY) {
+			continue;
+		}
+		Dictionary tier = p_tiers[i];
+		if (profile.cores < int(tier.get("min_cores", 0)) ||
+				profile.max_freq_mhz < int(tier.get("min_freq_mhz", 0)) ||
+				profile.ram_mb < int(tier.get("min_ram_mb", 0))) {
+			continue;
+		}
+		String model = tier.get("model", String());
+		if (!model.is_empty() && profile.model.findn(model) < 0) {
+			continue;
+		}
+		String renderer = tier.get("renderer", String());
+		if (!renderer.is_empty() && profile.renderer.findn(renderer) < 0) {
+			continue;
+		}
+		return tier;
+	}
+	return Dictionary();
+}
+
+String DeviceProfileSBC::to_string() const {
+	return vformat("%s, %d cores @ %d MHz, %d MiB RAM, %s", profile.model, profile.cores, profile.max_freq_mhz, profile.ram_mb, profile.renderer);
+}
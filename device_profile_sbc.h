@@ -0,0 +1,56 @@
+#ifndef DEVICE_PROFILE_SBC_H
+#define DEVICE_PROFILE_SBC_H
+
+#include "core/string/ustring.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+
+// Describes the board we're running on: device-tree model, CPU cores and
+// their top frequency, RAM and the GPU renderer string. The profile is
+// matched against the tier table in application/run/sbc/quality_tiers (first
+// entry whose minimums and substrings all match wins) so a single build can
+// pick its own defaults from a Pi 3 up to an RK3588.
+//
+// sysfs/procfs are read below $GODOT_SBC_SYSFS_ROOT when set, so the probe
+// can be pointed at a captured tree. Otherwise the tier decision is cached
+// in <cache>/godot_sbc/device_profile.cfg, keyed on the scanned model, CPU
+// count, top cpufreq, MemTotal, renderer and the tier table, so the matching
+// runs once per hardware configuration and any change to those decides again.
+class DeviceProfileSBC {
+public:
+	struct Profile {
+		String model;
+		int cores = 0;
+		int max_freq_mhz = 0;
+		int ram_mb = 0;
+		String renderer;
+	};
+
+private:
+	Profile profile;
+	bool probed = false;
+
+	static String _root();
+	static String _cache_path();
+	String _cache_key(const Array &p_tiers) const;
+	static String _read_first_line(const String &p_path);
+	static int _count_cpus(const String &p_list, int &r_last);
+	static int _read_mem_total_mb(const String &p_path);
+	void _scan(const String &p_root);
+
+public:
+	static Array get_default_tiers();
+
+	// Runs once; later calls return the same profile.
+	const Profile &probe(const String &p_renderer);
+	const Profile &get_profile() const { return profile; }
+	bool is_probed() const { return probed; }
+
+	// Returns the first tier matching the profile, or an empty Dictionary.
+	Dictionary select_tier(const Array &p_tiers) const;
+	// Same, reusing the tier picked last time for this profile and table.
+	Dictionary select_tier_cached(const Array &p_tiers, bool &r_cached) const;
+	String to_string() const;
+};
+
+#endif // DEVICE_PROFILE_SBC_H
@@ -1,8 +1,11 @@
 
 #include "display_server_sdl.h"
+#include "core/config/project_settings.h"
 #include "core/input/input.h"
 #include "core/input/input_event.h"
+#include "core/io/image.h"
 #include "os_sbc.h"
+#include "scene/main/viewport.h"
 #include "sdl_map.h"
 
 #ifdef GLES3_ENABLED
@@ -41,32 +44,76 @@ DisplayServerSDL::DisplayServerSDL(const String &p_rendering_driver, WindowMode
 		return;
 	}
 
-	ShowControllerInfo();
 	int flags = SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI;
 
 	inputHandler = Input::get_singleton();
 
+	touch_gestures_enabled = GLOBAL_DEF("input_devices/pointing/sbc/enable_touch_gestures", true);
+	touch_gestures_consume_drag = GLOBAL_DEF("input_devices/pointing/sbc/gestures_consume_screen_drag", false);
+	touch_gestures.set_thresholds(
+			GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "input_devices/pointing/sbc/gesture_magnify_threshold", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.05),
+			GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "input_devices/pointing/sbc/gesture_pan_threshold", PROPERTY_HINT_RANGE, "0,100,0.5,suffix:px"), 8.0));
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+	controller_sensors_enabled = GLOBAL_DEF("input_devices/sensors/sbc/enable_controller_sensors", false);
+#endif
+	ShowControllerInfo();
+
+	// Gestures are recognized from finger events below, SDL's own recognizer output is unused.
+	SDL_EventState(SDL_MULTIGESTURE, SDL_IGNORE);
+	SDL_EventState(SDL_DOLLARGESTURE, SDL_IGNORE);
+	SDL_EventState(SDL_DOLLARRECORD, SDL_IGNORE);
+
+	bool use_probe_cache = GLOBAL_DEF("rendering/sbc/cache_renderer_probe", true);
+	if (use_probe_cache) {
+		renderer_probe_cache.load();
+	}
+
 #ifdef VULKAN_ENABLED
 	if (rendering_driver == "vulkan") {
 		print_line("resolution: ", p_resolution.width, "x", p_resolution.height);
-		vulkan_context = memnew(RenderingContextDriverVulkanSDL);
-		if (!vulkan_context) {
-			printf("Vulkan context is null!\n");
-			r_error = ERR_CANT_CREATE;
-			return;
+
+		// Skipping the probe also keeps the Vulkan loader and ICDs from being loaded at all.
+		uint64_t failed_probe_usec = 0;
+		bool vulkan_ok = false;
+		if (use_probe_cache && renderer_probe_cache.is_known_failing("vulkan", failed_probe_usec)) {
+			uint64_t lookup_usec = renderer_probe_cache.get_load_usec();
+			print_line(vformat("Skipping Vulkan, it failed to initialize before on %s (startup saves about %d ms: %d ms probe, %d usec cache lookup).",
+					renderer_probe_cache.get_key(), (int64_t(failed_probe_usec) - int64_t(lookup_usec)) / 1000, failed_probe_usec / 1000, lookup_usec));
+		} else {
+			uint64_t probe_begin = OS::get_singleton()->get_ticks_usec();
+			vulkan_context = memnew(RenderingContextDriverVulkanSDL);
+			vulkan_ok = vulkan_context->initialize() == OK;
+			vulkan_probe_usec = OS::get_singleton()->get_ticks_usec() - probe_begin;
+			print_verbose(vformat("Vulkan initialization took %d usec.", vulkan_probe_usec));
+			if (!vulkan_ok) {
+				memdelete(vulkan_context);
+				vulkan_context = nullptr;
+				if (use_probe_cache) {
+					renderer_probe_cache.store("vulkan", false, vulkan_probe_usec);
+				}
+			}
 		}
 
-		if (vulkan_context->initialize() != OK) {
-			WARN_PRINT("Your video card drivers seem not to support the required Vulkan version, switching to GLES3.");
+		if (!vulkan_ok) {
 #ifdef GLES3_ENABLED
+			WARN_PRINT("Your video card drivers seem not to support the required Vulkan version, switching to GLES3.");
 			print_line("Switching to GLES3 rendering driver due to Vulkan initialization failure.");
 			rendering_driver = "opengl3";
 			OS::get_singleton()->set_current_rendering_method("gl_compatibility");
 			OS::get_singleton()->set_current_rendering_driver_name(rendering_driver);
+#else
+			// Also reached when the probe cache skipped Vulkan; vulkan_context is null either way.
+			ERR_PRINT("Your video card drivers seem not to support the required Vulkan version, and this build has no GLES3 fallback.");
+			r_error = ERR_UNAVAILABLE;
+			return;
 #endif // GLES3_ENABLED
 		} else {
 			print_line("Using Vulkan rendering driver.");
-			flags |= SDL_WINDOW_VULKAN;
+			// Headless surfaces don't come from the window, and the offscreen/dummy drivers reject Vulkan windows.
+			if (!RenderingContextDriverVulkanSDL::is_headless()) {
+				flags |= SDL_WINDOW_VULKAN;
+			}
 		}
 	}
 #endif
@@ -77,20 +124,78 @@ DisplayServerSDL::DisplayServerSDL(const String &p_rendering_driver, WindowMode
 		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
 		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
 		SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
-		SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
-		SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+
+		// The rasterizer draws into its own render targets and only blits to the
+		// backbuffer, so depth/stencil on the default framebuffer is usually dead weight.
+		bool depth_stencil = GLOBAL_DEF("rendering/gl_compatibility/sbc/framebuffer_depth_stencil", false);
+		SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, depth_stencil ? 24 : 0);
+		SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, depth_stencil ? 8 : 0);
+
+		int color_format = GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/gl_compatibility/sbc/framebuffer_color_format", PROPERTY_HINT_ENUM, "RGB565,RGB888,RGBA8888"), 1);
+		switch (color_format) {
+			case 0:
+				SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 5);
+				SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 6);
+				SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 5);
+				SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 0);
+				break;
+			case 2:
+				SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
+				SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+				SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
+				SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+				break;
+			default:
+				SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
+				SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+				SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
+				SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 0);
+				break;
+		}
+
+		// Skipping driver validation is only safe once errors can no longer be debugged.
+		bool no_error = GLOBAL_DEF("rendering/gl_compatibility/sbc/no_error_context", true);
+#if !defined(DEBUG_ENABLED) && SDL_VERSION_ATLEAST(2, 0, 6)
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_NO_ERROR, no_error ? 1 : 0);
+#else
+		(void)no_error;
+#endif
+
+#ifdef SDL_HINT_VIDEO_X11_FORCE_EGL
+		// Damage-aware swaps are an EGL feature; SDL's X11 backend otherwise picks GLX.
+		if (GLOBAL_DEF("rendering/gl_compatibility/sbc/damage_present", false)) {
+			SDL_SetHint(SDL_HINT_VIDEO_X11_FORCE_EGL, "1");
+		}
+#endif
 		flags |= SDL_WINDOW_OPENGL;
 	}
 #endif
 
 	print_line("Video Card Driver: " + String(SDL_GetCurrentVideoDriver()));
 
+	display_rotation = GLOBAL_DEF(PropertyInfo(Variant::INT, "display/window/sbc/rotation", PROPERTY_HINT_ENUM, "0:0,90:90,180:180,270:270"), 0);
+	if (display_rotation != 0 && display_rotation != 90 && display_rotation != 180 && display_rotation != 270) {
+		WARN_PRINT("display/window/sbc/rotation must be 0, 90, 180 or 270, ignoring.");
+		display_rotation = 0;
+	}
+#ifdef GLES3_ENABLED
+	if (rendering_driver == "opengl3") {
+		gl_rotation.set_rotation(display_rotation);
+	}
+#endif
+	if (display_rotation != 0 && rendering_driver != "opengl3") {
+		WARN_PRINT("Display rotation is only supported with the Compatibility renderer.");
+		display_rotation = 0;
+	}
+
+	// The requested resolution is the logical one.
+	Size2i physical_resolution = _rotate_size(p_resolution);
 	window = SDL_CreateWindow(
 			"Godot",
 			SDL_WINDOWPOS_UNDEFINED,
 			SDL_WINDOWPOS_UNDEFINED,
-			p_resolution.width,
-			p_resolution.height,
+			physical_resolution.width,
+			physical_resolution.height,
 			flags);
 
 	window_size = p_resolution;
@@ -102,6 +207,25 @@ DisplayServerSDL::DisplayServerSDL(const String &p_rendering_driver, WindowMode
 		ERR_FAIL_MSG("Failed to create SDL window: " + String(SDL_GetError()));
 	}
 
+	_update_window_cache();
+
+	fullscreen_size = GLOBAL_DEF("display/window/sbc/fullscreen_resolution", Vector2i());
+	fullscreen_refresh_rate = GLOBAL_DEF(PropertyInfo(Variant::INT, "display/window/sbc/fullscreen_refresh_rate", PROPERTY_HINT_RANGE, "0,240,1,suffix:Hz"), 0);
+	_update_fullscreen_mode();
+	if (fullscreen_mode_valid && (p_mode == WINDOW_MODE_FULLSCREEN || p_mode == WINDOW_MODE_EXCLUSIVE_FULLSCREEN)) {
+		window_set_mode(p_mode);
+	}
+
+	// 0 follows the display refresh rate.
+	float dynamic_resolution_fps = GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/sbc/dynamic_resolution/target_frame_rate", PROPERTY_HINT_RANGE, "0,240,1,suffix:fps"), 0);
+	dynamic_resolution.configure(
+			GLOBAL_DEF("rendering/sbc/dynamic_resolution/enabled", false),
+			GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/sbc/dynamic_resolution/min_scale", PROPERTY_HINT_RANGE, "0.25,1,0.01"), 0.5),
+			GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/sbc/dynamic_resolution/max_scale", PROPERTY_HINT_RANGE, "0.25,2,0.01"), 1.0),
+			GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/sbc/dynamic_resolution/step", PROPERTY_HINT_RANGE, "0.01,0.25,0.01"), 0.05),
+			GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/sbc/dynamic_resolution/hysteresis_frames", PROPERTY_HINT_RANGE, "1,300,1"), 30),
+			dynamic_resolution_fps > 0.0f ? dynamic_resolution_fps : screen_get_refresh_rate());
+
 #ifdef VULKAN_ENABLED
 	if (rendering_driver == "vulkan") {
 		print_line("resolution: ", p_resolution.width, "x", p_resolution.height);
@@ -109,6 +233,8 @@ DisplayServerSDL::DisplayServerSDL(const String &p_rendering_driver, WindowMode
 		RenderingContextDriverVulkanSDL::WindowPlatformData wpd;
 		wpd.window = window;
 		vulkan_context->window_create(DisplayServer::MAIN_WINDOW_ID, &wpd);
+		_resize_vulkan_surface();
+		vulkan_context->window_set_vsync_mode(MAIN_WINDOW_ID, vulkan_context->resolve_vsync_mode(MAIN_WINDOW_ID, p_vsync));
 
 		//print_line("Vulkan surface ID: " + itos(vulkan_surface_id));
 
@@ -121,20 +247,34 @@ DisplayServerSDL::DisplayServerSDL(const String &p_rendering_driver, WindowMode
 			// Resource cleanup here...
 			memdelete(rendering_device);
 			print_line("Failed to initialize rendering device: rendering_device=" + itos((uintptr_t)rendering_device));
-			print_line("Error initializing rendering device: " + itos((int)err));
-			ERR_FAIL_MSG("Failed to initialize rendering device: " + itos((int)err));
+			if (use_probe_cache) {
+				renderer_probe_cache.store("vulkan", false, vulkan_probe_usec);
+			}
+			ERR_PRINT("Failed to initialize rendering device: " + itos((int)err));
 			r_error = err;
 			return;
 		}
 		print_line("Rendering device initialized with Vulkan");
+		if (use_probe_cache) {
+			renderer_probe_cache.store("vulkan", true, vulkan_probe_usec);
+		}
 		rendering_device->screen_create(MAIN_WINDOW_ID);
 		RendererCompositorRD::make_current();
+		_probe_texture_formats();
+		OS_SBC::get_singleton()->apply_device_profile(rendering_device->get_device_name());
 	}
 #endif
 #ifdef GLES3_ENABLED
 	if (rendering_driver == "opengl3") {
 		if (gl_context == nullptr) {
 			gl_context = SDL_GL_CreateContext(window);
+#if !defined(DEBUG_ENABLED) && SDL_VERSION_ATLEAST(2, 0, 6)
+			if (!gl_context) {
+				// Some drivers reject KHR_no_error outright, retry with a regular context.
+				SDL_GL_SetAttribute(SDL_GL_CONTEXT_NO_ERROR, 0);
+				gl_context = SDL_GL_CreateContext(window);
+			}
+#endif
 
 			if (!gl_context) {
 				print_line("DisplayServerSDL: Failed to create OpenGL ES context: " + String(SDL_GetError()));
@@ -143,11 +283,31 @@ DisplayServerSDL::DisplayServerSDL(const String &p_rendering_driver, WindowMode
 			print_line("OpenGL ES context created");
 
 			SDL_GL_MakeCurrent(window, gl_context);
+			if (!GLProcLoaderSDL::load()) {
+				ERR_FAIL_MSG("Failed to load OpenGL ES entry points.");
+			}
+			_print_gl_framebuffer_config();
+			_probe_texture_formats();
+			OS_SBC::get_singleton()->apply_device_profile(String::utf8((const char *)glGetString(GL_RENDERER)));
 
+			vsync_mode = p_vsync;
 			SDL_GL_SetSwapInterval(get_sdl_swap_interval(p_vsync)); // Enable VSync
+			// Skipping frames only makes sense when nothing paces the swap anyway.
+			drop_busy_frames = GLOBAL_DEF("rendering/gl_compatibility/sbc/drop_busy_frames", false);
+			gl_presenter.set_drop_busy_frames(drop_busy_frames && p_vsync == VSYNC_DISABLED);
+			gl_presenter.set_damage_enabled(GLOBAL_DEF("rendering/gl_compatibility/sbc/damage_present", false));
+			gl_presenter.set_frames_in_flight(GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/gl_compatibility/sbc/max_frames_in_flight", PROPERTY_HINT_RANGE, "1,3,1"), 2));
 			print_line("VSync set to ", (get_sdl_swap_interval(p_vsync) ? "enabled" : "disabled"));
 			RasterizerGLES3::make_current(false);
 			print_line("Rasterizer initialized");
+
+			PackedInt32Array mirror_screens = GLOBAL_DEF(PropertyInfo(Variant::PACKED_INT32_ARRAY, "display/window/sbc/mirror_screens"), PackedInt32Array());
+			int mirror_stretch = GLOBAL_DEF(PropertyInfo(Variant::INT, "display/window/sbc/mirror_stretch", PROPERTY_HINT_ENUM, "Fit,Fill"), 0);
+			if (!mirror_screens.is_empty()) {
+				mirror_displays.open(mirror_screens, window_screen, GLRotationBlitSDL::Stretch(mirror_stretch));
+				// Mirrors draw from the offscreen copy of the frame.
+				gl_rotation.set_offscreen(!mirror_displays.is_empty());
+			}
 		}
 	}
 #endif
@@ -157,6 +317,24 @@ DisplayServerSDL::DisplayServerSDL(const String &p_rendering_driver, WindowMode
 	r_error = OK;
 }
 
+#ifdef GLES3_ENABLED
+void DisplayServerSDL::_print_gl_framebuffer_config() {
+	// What the driver actually granted, which may differ from the request.
+	int red = 0, green = 0, blue = 0, alpha = 0, depth = 0, stencil = 0, no_error = 0;
+	SDL_GL_GetAttribute(SDL_GL_RED_SIZE, &red);
+	SDL_GL_GetAttribute(SDL_GL_GREEN_SIZE, &green);
+	SDL_GL_GetAttribute(SDL_GL_BLUE_SIZE, &blue);
+	SDL_GL_GetAttribute(SDL_GL_ALPHA_SIZE, &alpha);
+	SDL_GL_GetAttribute(SDL_GL_DEPTH_SIZE, &depth);
+	SDL_GL_GetAttribute(SDL_GL_STENCIL_SIZE, &stencil);
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+	SDL_GL_GetAttribute(SDL_GL_CONTEXT_NO_ERROR, &no_error);
+#endif
+	print_line(vformat("Default framebuffer: R%dG%dB%dA%d, depth %d, stencil %d, no_error %s",
+			red, green, blue, alpha, depth, stencil, no_error ? "on" : "off"));
+}
+#endif
+
 // Make the dispatch function static for Input::set_event_dispatch_function
 void DisplayServerSDL::event_dispatch_function(const Ref<InputEvent> &event) {
 	// You may need to access a singleton or global instance here if needed.
@@ -189,23 +367,21 @@ void DisplayServerSDL::ShowControllerInfo() {
 	// Initialize joysticks
 	if (num_joysticks < 0) {
 		fprintf(stderr, "Could not get joystick count from SDL, Error: %s\n", SDL_GetError());
-	} else {
-		for (int i = 0; i < num_joysticks; ++i) {
-			SDL_Joystick *joystick = SDL_JoystickOpen(i);
-			if (joystick) {
-				SDL_JoystickID id = SDL_JoystickInstanceID(joystick);
-				joysticks[id] = joystick;
-				print_line("Joystick connected: " + String(SDL_JoystickName(joystick)));
-			} else {
-				fprintf(stderr, "Could not open joystick %d, Error: %s\n", i, SDL_GetError());
-			}
-		}
+		return;
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_joysticks; ++i) {
+		_handle_device_added(i);
 	}
+	print_verbose("Joypad enumeration opened " + itos(num_joysticks) + " devices in " + itos(OS::get_singleton()->get_ticks_usec() - begin) + " usec.");
 }
 
 bool DisplayServerSDL::has_feature(Feature p_feature) const {
 	switch (p_feature) {
 		case FEATURE_MOUSE:
+		case FEATURE_CURSOR_SHAPE:
+		case FEATURE_CUSTOM_CURSOR_SHAPE:
 		case FEATURE_ICON:
 		case FEATURE_SWAP_BUFFERS:
 			return true;
@@ -217,7 +393,23 @@ bool DisplayServerSDL::has_feature(Feature p_feature) const {
 void DisplayServerSDL::swap_buffers() {
 #ifdef GLES3_ENABLED
 	if (rendering_driver == "opengl3" && gl_context) {
-		SDL_GL_SwapWindow(window);
+		if (swap_interval_dirty.is_set()) {
+			swap_interval_dirty.clear();
+			SDL_GL_SetSwapInterval(requested_swap_interval);
+			gl_presenter.set_drop_busy_frames(requested_drop_busy_frames);
+		}
+
+		int drawable_width = 0, drawable_height = 0;
+		SDL_GL_GetDrawableSize(window, &drawable_width, &drawable_height);
+		gl_rotation.present(Size2i(drawable_width, drawable_height));
+		frame_capture.capture(drawable_width, drawable_height);
+
+		dynamic_resolution.gpu_frame_end();
+		uint64_t present_begin = OS::get_singleton()->get_ticks_usec();
+		gl_presenter.present(window);
+		OS_SBC::get_singleton()->get_frame_pacer().notify_present(present_begin, OS::get_singleton()->get_ticks_usec());
+		mirror_displays.present(window, gl_context, gl_rotation);
+		dynamic_resolution.gpu_frame_begin();
 	}
 #endif
 #ifdef VULKAN_ENABLED
@@ -226,6 +418,30 @@ void DisplayServerSDL::swap_buffers() {
 #endif
 }
 
+void DisplayServerSDL::release_rendering_thread() {
+	gl_window_release_current();
+}
+
+// With thread_model=separate, RenderingServerDefault::_thread_loop takes the
+// context with gl_window_make_current() once the main thread has released it.
+void DisplayServerSDL::gl_window_make_current(DisplayServer::WindowID p_window_id) {
+#ifdef GLES3_ENABLED
+	if (rendering_driver == "opengl3" && gl_context) {
+		if (SDL_GL_MakeCurrent(window, gl_context) != 0) {
+			ERR_PRINT("Failed to make the OpenGL context current: " + String(SDL_GetError()));
+		}
+	}
+#endif
+}
+
+void DisplayServerSDL::gl_window_release_current() {
+#ifdef GLES3_ENABLED
+	if (rendering_driver == "opengl3" && gl_context) {
+		SDL_GL_MakeCurrent(window, nullptr);
+	}
+#endif
+}
+
 String DisplayServerSDL::get_name() const {
 	return "sbc";
 }
@@ -245,17 +461,27 @@ int DisplayServerSDL::get_primary_screen() const {
 }
 
 Point2i DisplayServerSDL::screen_get_position(int p_screen) const {
-	int w, h;
-	SDL_GetWindowPosition(window, &w, &h);
-	return Point2i(w, h);
+	if (p_screen < 0 || p_screen == window_screen) {
+		return screen_rect.position;
+	}
+
+	SDL_Rect bounds;
+	if (SDL_GetDisplayBounds(p_screen, &bounds) != 0) {
+		return Point2i(0, 0);
+	}
+	return Point2i(bounds.x, bounds.y);
 }
 
 Size2i DisplayServerSDL::screen_get_size(int p_screen) const {
-	int w, h;
-
-	SDL_GetWindowSize(window, &w, &h);
+	if (p_screen < 0 || p_screen == window_screen) {
+		return screen_rect.size;
+	}
 
-	return Size2i(w, h);
+	SDL_Rect bounds;
+	if (SDL_GetDisplayBounds(p_screen, &bounds) != 0) {
+		return Size2i(0, 0);
+	}
+	return _rotate_size(Size2i(bounds.w, bounds.h));
 }
 
 int DisplayServerSDL::screen_get_dpi(int p_screen) const {
@@ -292,6 +518,11 @@ void DisplayServerSDL::initialize_gl_context() {
 void DisplayServerSDL::_destroy_window() {
 #ifdef GLES3_ENABLED
 	if (gl_context) {
+		gl_rotation.release();
+		mirror_displays.close();
+		frame_capture.release();
+		gl_presenter.release();
+		dynamic_resolution.gpu_release();
 		SDL_GL_DeleteContext(gl_context);
 		gl_context = nullptr;
 	}
@@ -311,6 +542,7 @@ void DisplayServerSDL::_destroy_window() {
 	}
 
 #endif
+	_free_cursors();
 	if (window) {
 		SDL_DestroyWindow(window);
 		window = nullptr;
@@ -319,6 +551,231 @@ void DisplayServerSDL::_destroy_window() {
 	SDL_Quit();
 }
 
+void DisplayServerSDL::_update_window_cache() {
+	if (!window) {
+		return;
+	}
+
+	int w, h, x, y;
+	SDL_GetWindowSize(window, &w, &h);
+	SDL_GetWindowPosition(window, &x, &y);
+	window_size = _rotate_size(Size2i(w, h));
+	window_position = Point2i(x, y);
+
+	Uint32 window_flags = SDL_GetWindowFlags(window);
+	window_focused = (window_flags & SDL_WINDOW_INPUT_FOCUS) != 0;
+	window_visible = (window_flags & SDL_WINDOW_SHOWN) != 0;
+	window_minimized = (window_flags & SDL_WINDOW_MINIMIZED) != 0;
+
+	_update_screen_cache();
+}
+
+bool DisplayServerSDL::_update_screen_cache() {
+	int display = SDL_GetWindowDisplayIndex(window);
+	if (display < 0) {
+		fprintf(stderr, "Could not get the current display from SDL, Error: %s\n", SDL_GetError());
+		display = 0;
+	}
+	bool screen_changed = display != window_screen;
+	window_screen = display;
+
+	SDL_Rect bounds;
+	if (SDL_GetDisplayBounds(display, &bounds) == 0) {
+		screen_rect = Rect2i(Point2i(bounds.x, bounds.y), _rotate_size(Size2i(bounds.w, bounds.h)));
+	} else {
+		screen_rect = Rect2i(Point2i(), window_size);
+	}
+
+	// Modes and the resolved fullscreen mode belong to the old screen.
+	if (screen_changed) {
+		_reset_display_modes();
+	}
+	return screen_changed;
+}
+
+#ifdef VULKAN_ENABLED
+void DisplayServerSDL::_resize_vulkan_surface() {
+	if (rendering_driver != "vulkan" || !vulkan_context) {
+		return;
+	}
+	// The swapchain is sized in pixels, which differ from window units on high-DPI outputs.
+	int width = 0, height = 0;
+	SDL_Vulkan_GetDrawableSize(window, &width, &height);
+	vulkan_context->window_set_size(MAIN_WINDOW_ID, width, height);
+}
+#endif
+
+void DisplayServerSDL::_probe_texture_formats() {
+	// Only formats the GPU samples directly are advertised; anything else
+	// would be decompressed on the CPU at load.
+	uint32_t formats = 0;
+#ifdef GLES3_ENABLED
+	if (rendering_driver == "opengl3" && gl_context) {
+		formats |= OS_SBC::TEXTURE_FORMAT_ETC2; // Core in OpenGL ES 3.0.
+		if (SDL_GL_ExtensionSupported("GL_KHR_texture_compression_astc_ldr") || SDL_GL_ExtensionSupported("GL_OES_texture_compression_astc")) {
+			formats |= OS_SBC::TEXTURE_FORMAT_ASTC;
+		}
+		if (SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc")) {
+			formats |= OS_SBC::TEXTURE_FORMAT_S3TC;
+		}
+		if (SDL_GL_ExtensionSupported("GL_EXT_texture_compression_bptc") || SDL_GL_ExtensionSupported("GL_ARB_texture_compression_bptc")) {
+			formats |= OS_SBC::TEXTURE_FORMAT_BPTC;
+		}
+	}
+#endif
+#ifdef VULKAN_ENABLED
+	if (rendering_driver == "vulkan" && rendering_device) {
+		const RD::TextureUsageBits usage = RD::TEXTURE_USAGE_SAMPLING_BIT;
+		if (rendering_device->texture_is_format_supported_for_usage(RD::DATA_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, usage)) {
+			formats |= OS_SBC::TEXTURE_FORMAT_ETC2;
+		}
+		if (rendering_device->texture_is_format_supported_for_usage(RD::DATA_FORMAT_ASTC_4x4_UNORM_BLOCK, usage)) {
+			formats |= OS_SBC::TEXTURE_FORMAT_ASTC;
+		}
+		if (rendering_device->texture_is_format_supported_for_usage(RD::DATA_FORMAT_BC3_UNORM_BLOCK, usage)) {
+			formats |= OS_SBC::TEXTURE_FORMAT_S3TC;
+		}
+		if (rendering_device->texture_is_format_supported_for_usage(RD::DATA_FORMAT_BC7_UNORM_BLOCK, usage)) {
+			formats |= OS_SBC::TEXTURE_FORMAT_BPTC;
+		}
+	}
+#endif
+	OS_SBC::get_singleton()->set_texture_formats(formats);
+}
+
+bool DisplayServerSDL::_is_mirror_window(Uint32 p_window_id) const {
+#ifdef GLES3_ENABLED
+	return mirror_displays.owns_window(p_window_id);
+#else
+	return false;
+#endif
+}
+
+Size2i DisplayServerSDL::_rotate_size(const Size2i &p_size) const {
+	// Swapping is its own inverse, so this maps both ways.
+	if (display_rotation == 90 || display_rotation == 270) {
+		return Size2i(p_size.height, p_size.width);
+	}
+	return p_size;
+}
+
+Vector2 DisplayServerSDL::_physical_to_logical(const Vector2 &p_point) const {
+	const Size2i physical = _rotate_size(window_size);
+	switch (display_rotation) {
+		case 90:
+			return Vector2(p_point.y, physical.width - p_point.x);
+		case 180:
+			return Vector2(physical.width - p_point.x, physical.height - p_point.y);
+		case 270:
+			return Vector2(physical.height - p_point.y, p_point.x);
+		default:
+			return p_point;
+	}
+}
+
+Vector2 DisplayServerSDL::_physical_to_logical_relative(const Vector2 &p_relative) const {
+	switch (display_rotation) {
+		case 90:
+			return Vector2(p_relative.y, -p_relative.x);
+		case 180:
+			return -p_relative;
+		case 270:
+			return Vector2(-p_relative.y, p_relative.x);
+		default:
+			return p_relative;
+	}
+}
+
+void DisplayServerSDL::_send_window_event(WindowEvent p_event) {
+	Variant arg0 = int(p_event);
+	invoke_callback_dispatch_events(window_event_callback, arg0);
+}
+
+void DisplayServerSDL::_flush_rect_changed() {
+	if (!rect_changed_pending) {
+		return;
+	}
+	if (OS::get_singleton()->get_ticks_msec() - rect_changed_ticks < RECT_CHANGED_DEBOUNCE_MSEC) {
+		return; // Still resizing, wait for the storm to settle.
+	}
+	rect_changed_pending = false;
+
+	Variant arg0 = Rect2i(window_position, window_size);
+	invoke_callback_dispatch_events(rect_changed_callback, arg0);
+}
+
+void DisplayServerSDL::_update_dynamic_resolution() {
+	if (!dynamic_resolution.is_enabled()) {
+		return;
+	}
+	if (!dynamic_resolution.update(OS_SBC::get_singleton()->get_frame_pacer().get_last_frame_cost_usec())) {
+		return;
+	}
+
+	// The attached instance is the root Window; only its 3D scale is adjustable at runtime.
+	Viewport *viewport = Object::cast_to<Viewport>(ObjectDB::get_instance(attached_instance_id));
+	if (viewport) {
+		viewport->set_scaling_3d_scale(dynamic_resolution.get_scale());
+	}
+}
+
+void DisplayServerSDL::present_add_damage(const TypedArray<Rect2i> &p_rects) {
+#ifdef GLES3_ENABLED
+	// Logical, top-left origin rects become panel-space rects with GL's bottom-left origin.
+	const Size2i physical = _rotate_size(window_size);
+	LocalVector<Rect2i> rects;
+	for (int i = 0; i < p_rects.size(); i++) {
+		Rect2i rect = p_rects[i];
+		Rect2i panel;
+		switch (display_rotation) {
+			case 90:
+				panel = Rect2i(physical.width - rect.position.y - rect.size.y, rect.position.x, rect.size.y, rect.size.x);
+				break;
+			case 180:
+				panel = Rect2i(physical.width - rect.position.x - rect.size.x, physical.height - rect.position.y - rect.size.y, rect.size.x, rect.size.y);
+				break;
+			case 270:
+				panel = Rect2i(rect.position.y, physical.height - rect.position.x - rect.size.x, rect.size.y, rect.size.x);
+				break;
+			default:
+				panel = rect;
+				break;
+		}
+		panel = panel.intersection(Rect2i(Point2i(), physical));
+		if (panel.has_area()) {
+			panel.position.y = physical.height - panel.position.y - panel.size.y;
+			rects.push_back(panel);
+		}
+	}
+	gl_presenter.add_damage(rects);
+#endif
+}
+
+Error DisplayServerSDL::frame_capture_start(const String &p_path, int p_ring_size) {
+#ifdef GLES3_ENABLED
+	if (rendering_driver == "opengl3" && gl_context) {
+		int width = 0, height = 0;
+		SDL_GL_GetDrawableSize(window, &width, &height);
+		return frame_capture.start(p_path, width, height, p_ring_size);
+	}
+#endif
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Frame capture is only available with the Compatibility renderer.");
+}
+
+void DisplayServerSDL::frame_capture_stop() {
+#ifdef GLES3_ENABLED
+	frame_capture.stop();
+#endif
+}
+
+float DisplayServerSDL::get_dynamic_resolution_scale() const {
+	return dynamic_resolution.get_scale();
+}
+
+PackedStringArray DisplayServerSDL::get_dynamic_resolution_log() const {
+	return dynamic_resolution.get_log();
+}
+
 void DisplayServerSDL::window_set_title(const String &p_title, WindowID p_window) {
 	if (window) {
 		SDL_SetWindowTitle(window, p_title.utf8().get_data());
@@ -328,15 +785,13 @@ void DisplayServerSDL::window_set_title(const String &p_title, WindowID p_window
 void DisplayServerSDL::window_set_size(const Size2i p_size, WindowID p_window) {
 	window_size = p_size;
 	if (window) {
-		SDL_SetWindowSize(window, p_size.x, p_size.y);
+		Size2i physical = _rotate_size(p_size);
+		SDL_SetWindowSize(window, physical.x, physical.y);
 	}
 }
 
 Size2i DisplayServerSDL::window_get_size(WindowID p_window) const {
-	int w, h;
-	SDL_GetWindowSize(window, &w, &h);
-
-	return Size2i(w, h);
+	return window_size;
 }
 
 void DisplayServerSDL::window_set_mode(WindowMode p_mode, WindowID p_window) {
@@ -347,6 +802,15 @@ void DisplayServerSDL::window_set_mode(WindowMode p_mode, WindowID p_window) {
 
 	switch (p_mode) {
 		case WINDOW_MODE_FULLSCREEN:
+		case WINDOW_MODE_EXCLUSIVE_FULLSCREEN:
+			if (fullscreen_mode_valid && memcmp(&fullscreen_mode, &applied_mode, sizeof(SDL_DisplayMode)) != 0) {
+				// Only touch the mode when it actually changes, a modeset costs the display a resync.
+				if (SDL_SetWindowDisplayMode(window, &fullscreen_mode) == 0) {
+					applied_mode = fullscreen_mode;
+				} else {
+					WARN_PRINT("Could not set the fullscreen display mode: " + String(SDL_GetError()));
+				}
+			}
 			SDL_SetWindowFullscreen(window, SDL_WINDOW_FULLSCREEN);
 			break;
 		case WINDOW_MODE_WINDOWED:
@@ -357,6 +821,93 @@ void DisplayServerSDL::window_set_mode(WindowMode p_mode, WindowID p_window) {
 	}
 }
 
+void DisplayServerSDL::_reset_display_modes() {
+	display_modes_screen = -1;
+	display_modes.clear();
+	// Whatever was set before may not be what the connector runs now.
+	applied_mode = {};
+	_update_fullscreen_mode();
+	if (fullscreen_mode_valid && (window_mode == WINDOW_MODE_FULLSCREEN || window_mode == WINDOW_MODE_EXCLUSIVE_FULLSCREEN)) {
+		window_set_mode(window_mode);
+	}
+}
+
+const LocalVector<SDL_DisplayMode> &DisplayServerSDL::_get_display_modes(int p_screen) {
+	if (p_screen != display_modes_screen) {
+		display_modes.clear();
+		int count = SDL_GetNumDisplayModes(p_screen);
+		for (int i = 0; i < count; i++) {
+			SDL_DisplayMode mode;
+			if (SDL_GetDisplayMode(p_screen, i, &mode) == 0) {
+				display_modes.push_back(mode);
+			}
+		}
+		display_modes_screen = p_screen;
+	}
+	return display_modes;
+}
+
+void DisplayServerSDL::_update_fullscreen_mode() {
+	fullscreen_mode_valid = false;
+	if (fullscreen_size.x <= 0 || fullscreen_size.y <= 0) {
+		return;
+	}
+
+	// Modes come sorted by size, then refresh rate, both descending. Take the
+	// exact size at the requested rate, or its highest rate when none matches.
+	Size2i physical = _rotate_size(fullscreen_size);
+	for (const SDL_DisplayMode &mode : _get_display_modes(window_screen)) {
+		if (mode.w != physical.x || mode.h != physical.y) {
+			continue;
+		}
+		if (!fullscreen_mode_valid || mode.refresh_rate == fullscreen_refresh_rate) {
+			fullscreen_mode = mode;
+			fullscreen_mode_valid = true;
+		}
+	}
+
+	if (!fullscreen_mode_valid) {
+		SDL_DisplayMode wanted = {};
+		wanted.w = physical.x;
+		wanted.h = physical.y;
+		wanted.refresh_rate = fullscreen_refresh_rate;
+		fullscreen_mode_valid = SDL_GetClosestDisplayMode(window_screen, &wanted, &fullscreen_mode) != nullptr;
+	}
+
+	if (fullscreen_mode_valid) {
+		print_line(vformat("Fullscreen display mode: %dx%d @ %d Hz", fullscreen_mode.w, fullscreen_mode.h, fullscreen_mode.refresh_rate));
+	} else {
+		WARN_PRINT(vformat("No display mode close to %dx%d on screen %d, fullscreen keeps the window size.", physical.x, physical.y, window_screen));
+	}
+}
+
+TypedArray<Dictionary> DisplayServerSDL::get_fullscreen_display_modes(int p_screen) {
+	if (p_screen < 0) {
+		p_screen = window_screen;
+	}
+	TypedArray<Dictionary> modes;
+	for (const SDL_DisplayMode &mode : _get_display_modes(p_screen)) {
+		Dictionary entry;
+		entry["size"] = _rotate_size(Size2i(mode.w, mode.h));
+		entry["refresh_rate"] = mode.refresh_rate;
+		modes.push_back(entry);
+	}
+	return modes;
+}
+
+void DisplayServerSDL::set_fullscreen_display_mode(const Vector2i &p_size, int p_refresh_rate) {
+	fullscreen_size = p_size;
+	fullscreen_refresh_rate = p_refresh_rate;
+	_update_fullscreen_mode();
+	if (window_mode == WINDOW_MODE_FULLSCREEN || window_mode == WINDOW_MODE_EXCLUSIVE_FULLSCREEN) {
+		window_set_mode(window_mode);
+	}
+}
+
+Vector2i DisplayServerSDL::get_fullscreen_display_mode_size() const {
+	return fullscreen_mode_valid ? _rotate_size(Size2i(fullscreen_mode.w, fullscreen_mode.h)) : Size2i();
+}
+
 DisplayServer::WindowMode DisplayServerSDL::window_get_mode(WindowID p_window) const {
 	return window_mode;
 }
@@ -456,13 +1007,7 @@ float DisplayServerSDL::screen_get_refresh_rate(int p_screen) const {
 }
 
 int DisplayServerSDL::window_get_current_screen(WindowID p_window) const {
-	int current_display = SDL_GetWindowDisplayIndex(window);
-
-	if (current_display < 0) {
-		fprintf(stderr, "Could not get the current display from SDL, Error: %s\n", SDL_GetError());
-	}
-
-	return current_display;
+	return window_screen;
 }
 
 void DisplayServerSDL::window_set_current_screen(int p_screen, WindowID p_window) {
@@ -484,24 +1029,15 @@ void DisplayServerSDL::window_set_current_screen(int p_screen, WindowID p_window
 }
 
 Point2i DisplayServerSDL::window_get_position(WindowID p_window) const {
-	if (window) {
-		int x, y;
-		SDL_GetWindowPosition(window, &x, &y);
-		return Point2i(x, y);
-	}
-	return Point2i(0, 0);
+	return window_position;
 }
 
 Point2i DisplayServerSDL::window_get_position_with_decorations(WindowID p_window) const {
-	if (window) {
-		int x, y;
-		SDL_GetWindowPosition(window, &x, &y);
-		return Point2i(x, y);
-	}
-	return Point2i(0, 0);
+	return window_position;
 }
 
 void DisplayServerSDL::window_set_position(const Point2i &p_position, WindowID p_window) {
+	window_position = p_position;
 	if (window) {
 		SDL_SetWindowPosition(window, p_position.x, p_position.y);
 	}
@@ -541,12 +1077,7 @@ Size2i DisplayServerSDL::window_get_min_size(WindowID p_window) const {
 }
 
 Size2i DisplayServerSDL::window_get_size_with_decorations(WindowID p_window) const {
-	if (window) {
-		int width, height;
-		SDL_GetWindowSize(window, &width, &height);
-		return Size2i(width, height);
-	}
-	return Size2i(0, 0);
+	return window_size;
 }
 
 bool DisplayServerSDL::window_is_maximize_allowed(WindowID p_window) const {
@@ -603,24 +1134,16 @@ void DisplayServerSDL::window_move_to_foreground(WindowID p_window) {
 }
 
 bool DisplayServerSDL::window_is_focused(WindowID p_window) const {
-	if (window) {
-		return SDL_GetWindowFlags(window) & SDL_WINDOW_INPUT_FOCUS;
-	}
-	return false;
+	return window_focused;
 }
 
 bool DisplayServerSDL::window_can_draw(WindowID p_window) const {
-	if (window) {
-		return SDL_GetWindowFlags(window) & SDL_WINDOW_SHOWN;
-	}
-	return false;
+	// Hidden and minimized windows skip rendering entirely.
+	return window && window_visible && !window_minimized;
 }
 
 bool DisplayServerSDL::can_any_window_draw() const {
-	if (window) {
-		return SDL_GetWindowFlags(window) & SDL_WINDOW_SHOWN;
-	}
-	return false;
+	return window_can_draw(MAIN_WINDOW_ID);
 }
 int c = 0;
 void DisplayServerSDL::process_events() {
@@ -638,34 +1161,61 @@ void DisplayServerSDL::process_events() {
 			case SDL_MOUSEWHEEL:
 			case SDL_MOUSEBUTTONUP:
 			case SDL_MOUSEBUTTONDOWN:
+				if (_is_mirror_window(event.motion.windowID)) {
+					break; // Mirrors only display; input belongs to the main window.
+				}
 				_process_sdl_mouse_event(event);
 				break;
 			case SDL_JOYAXISMOTION:
 			case SDL_JOYHATMOTION:
 			case SDL_JOYBUTTONDOWN:
 			case SDL_JOYBUTTONUP:
+				_process_sdl_joystick_event(event);
+				break;
 			case SDL_JOYDEVICEADDED:
+				// Also sent for game controllers, so SDL_CONTROLLERDEVICEADDED is not needed.
+				_handle_device_added(event.jdevice.which);
+				break;
 			case SDL_JOYDEVICEREMOVED:
-				_process_sdl_joystick_event(event);
+				_handle_device_removed(event.jdevice.which);
 				break;
 			case SDL_CONTROLLERAXISMOTION:
 			case SDL_CONTROLLERBUTTONDOWN:
 			case SDL_CONTROLLERBUTTONUP:
-			case SDL_CONTROLLERDEVICEADDED:
-			case SDL_CONTROLLERDEVICEREMOVED:
 			case SDL_CONTROLLERDEVICEREMAPPED:
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+			case SDL_CONTROLLERSENSORUPDATE:
+#endif
 				_process_sdl_gamecontroller_event(event);
 				break;
 			case SDL_FINGERDOWN:
 			case SDL_FINGERUP:
 			case SDL_FINGERMOTION:
 				_process_sdl_touch_event(event);
+				break;
+			case SDL_WINDOWEVENT:
+				if (_is_mirror_window(event.window.windowID)) {
+					break;
+				}
+				_process_sdl_window_event(event.window);
+				break;
+#if SDL_VERSION_ATLEAST(2, 0, 9)
+			case SDL_DISPLAYEVENT:
+				// Connectors and their modes can change under us (TV hotplug, EDID reread).
+				if (!_update_screen_cache()) {
+					_reset_display_modes();
+				}
+				break;
+#endif
 			case SDL_QUIT:
 				OS_SBC::get_singleton()->set_quit_requested(true);
 				break;
 		}
 	}
 
+	_flush_rect_changed();
+	_flush_touch_gestures();
+	_update_dynamic_resolution();
 	inputHandler->flush_buffered_events();
 }
 
@@ -712,8 +1262,11 @@ void DisplayServerSDL::window_set_vsync_mode(VSyncMode p_vsync_mode, WindowID p_
 #ifdef GLES3_ENABLED
 	if (rendering_driver == "opengl3" && gl_context) {
 		int swap_interval = get_sdl_swap_interval(p_vsync_mode);
-		SDL_GL_SetSwapInterval(swap_interval);
-		print_line("VSync mode set to ", swap_interval == 0 ? "disabled" : (swap_interval == 1 ? "enabled" : "adaptive"));
+		vsync_mode = p_vsync_mode;
+		requested_swap_interval = swap_interval;
+		requested_drop_busy_frames = drop_busy_frames && p_vsync_mode == VSYNC_DISABLED;
+		swap_interval_dirty.set();
+		print_line("VSync mode set to ", swap_interval == 0 ? "disabled" : (swap_interval == 1 ? "enabled" : "adaptive"), p_vsync_mode == VSYNC_MAILBOX ? " (no mailbox in OpenGL ES)" : "");
 	}
 #endif
 
@@ -725,12 +1278,12 @@ void DisplayServerSDL::window_set_vsync_mode(VSyncMode p_vsync_mode, WindowID p_
 			// In safe mode, we do not change VSync settings.
 			print_line("Safe mode is enabled, skipping VSync mode change.");
 		} else {
-			vulkan_context->window_set_vsync_mode(p_window, p_vsync_mode);
-			print_line("VSync mode set to ", p_vsync_mode == VSYNC_DISABLED ? "disabled" : (p_vsync_mode == VSYNC_ENABLED ? "enabled" : "adaptive"));
+			// Marks the surface for resize, so the swapchain is recreated with the
+			// new present mode before the next frame is acquired.
+			VSyncMode resolved = vulkan_context->resolve_vsync_mode(p_window, p_vsync_mode);
+			vulkan_context->window_set_vsync_mode(p_window, resolved);
+			print_line("VSync mode set to ", resolved == VSYNC_DISABLED ? "disabled" : (resolved == VSYNC_ENABLED ? "enabled" : (resolved == VSYNC_MAILBOX ? "mailbox" : "adaptive")));
 		}
-		// NOTE: In Vulkan, changing VSync requires recreating the swapchain with a different presentation mode.
-		// You should mark the surface for recreation, typically with surface_set_needs_resize or similar.
-		// This is important because Vulkan does not allow dynamic VSync changes like OpenGL.
 	}
 #endif
 }
@@ -738,17 +1291,8 @@ void DisplayServerSDL::window_set_vsync_mode(VSyncMode p_vsync_mode, WindowID p_
 DisplayServer::VSyncMode DisplayServerSDL::window_get_vsync_mode(WindowID p_window) const {
 #ifdef GLES3_ENABLED
 	if (rendering_driver == "opengl3" && gl_context) {
-		int interval = SDL_GL_GetSwapInterval();
-		switch (interval) {
-			case 0:
-				return VSYNC_DISABLED;
-			case 1:
-				return VSYNC_ENABLED;
-			case -1:
-				return VSYNC_ADAPTIVE;
-			default:
-				return VSYNC_ENABLED;
-		}
+		// SDL_GL_GetSwapInterval only works on the thread owning the context.
+		return vsync_mode;
 	}
 #endif
 #ifdef VULKAN_ENABLED
@@ -809,11 +1353,11 @@ void DisplayServerSDL::_process_sdl_mouse_event(const SDL_Event &event) {
 	Ref<InputEvent> ie;
 	switch (event.type) {
 		case SDL_MOUSEMOTION: {
-			last_mouse_pos = Vector2(event.motion.x, event.motion.y);
+			last_mouse_pos = _physical_to_logical(Vector2(event.motion.x, event.motion.y));
 			Ref<InputEventMouseMotion> mouse_motion;
 			mouse_motion.instantiate();
 			mouse_motion->set_position(last_mouse_pos);
-			mouse_motion->set_relative(Vector2(event.motion.xrel, event.motion.yrel));
+			mouse_motion->set_relative(_physical_to_logical_relative(Vector2(event.motion.xrel, event.motion.yrel)));
 			mouse_motion->set_button_mask(inputHandler->get_mouse_button_mask());
 			mouse_motion->set_pressure(1.0);
 			ie = mouse_motion;
@@ -821,7 +1365,7 @@ void DisplayServerSDL::_process_sdl_mouse_event(const SDL_Event &event) {
 		}
 		case SDL_MOUSEBUTTONDOWN:
 		case SDL_MOUSEBUTTONUP: {
-			last_mouse_pos = Vector2(event.button.x, event.button.y);
+			last_mouse_pos = _physical_to_logical(Vector2(event.button.x, event.button.y));
 			Ref<InputEventMouseButton> mouse_button;
 			mouse_button.instantiate();
 			mouse_button->set_position(last_mouse_pos);
@@ -859,14 +1403,14 @@ void DisplayServerSDL::_process_sdl_mouse_event(const SDL_Event &event) {
 }
 
 void DisplayServerSDL::_process_sdl_text_input(const SDL_TextInputEvent &text_event) {
-	String utf8_text = String::utf8(text_event.text);
+	// Decode the fixed-size SDL buffer in place, no intermediate String.
+	const char *text = text_event.text;
+	const int len = strnlen(text, SDL_TEXTINPUTEVENT_TEXT_SIZE);
 
-	// Process each character in the UTF-8 string
-	if (utf8_text.is_empty()) {
-		return; // No text to process
-	}
-	for (int i = 0; i < utf8_text.length(); ++i) {
-		char32_t codepoint = utf8_text.unicode_at(i);
+	int i = 0;
+	while (i < len) {
+		char32_t codepoint = 0;
+		i += sdl_utf8_decode(text + i, len - i, codepoint);
 
 		Ref<InputEventKey> ev;
 		ev.instantiate();
@@ -880,40 +1424,105 @@ void DisplayServerSDL::_process_sdl_text_input(const SDL_TextInputEvent &text_ev
 	}
 }
 
+void DisplayServerSDL::_process_sdl_window_event(const SDL_WindowEvent &window_event) {
+	switch (window_event.event) {
+		case SDL_WINDOWEVENT_SHOWN:
+		case SDL_WINDOWEVENT_EXPOSED:
+			window_visible = true;
+			break;
+		case SDL_WINDOWEVENT_HIDDEN:
+			window_visible = false;
+			break;
+		case SDL_WINDOWEVENT_MINIMIZED:
+			window_minimized = true;
+			break;
+		case SDL_WINDOWEVENT_MAXIMIZED:
+		case SDL_WINDOWEVENT_RESTORED:
+			window_minimized = false;
+			break;
+		case SDL_WINDOWEVENT_MOVED:
+			window_position = Point2i(window_event.data1, window_event.data2);
+			_update_screen_cache();
+			rect_changed_pending = true;
+			rect_changed_ticks = OS::get_singleton()->get_ticks_msec();
+			break;
+		case SDL_WINDOWEVENT_SIZE_CHANGED:
+			// Also sent for SDL_WINDOWEVENT_RESIZED, so only this one is handled.
+			window_size = _rotate_size(Size2i(window_event.data1, window_event.data2));
+#ifdef VULKAN_ENABLED
+			_resize_vulkan_surface();
+#endif
+			rect_changed_pending = true;
+			rect_changed_ticks = OS::get_singleton()->get_ticks_msec();
+			break;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+		case SDL_WINDOWEVENT_DISPLAY_CHANGED:
+			_update_screen_cache();
+			break;
+#endif
+		case SDL_WINDOWEVENT_FOCUS_GAINED:
+			window_focused = true;
+			_send_window_event(WINDOW_EVENT_FOCUS_IN);
+			break;
+		case SDL_WINDOWEVENT_FOCUS_LOST:
+			window_focused = false;
+			_send_window_event(WINDOW_EVENT_FOCUS_OUT);
+			break;
+		case SDL_WINDOWEVENT_ENTER:
+			_send_window_event(WINDOW_EVENT_MOUSE_ENTER);
+			break;
+		case SDL_WINDOWEVENT_LEAVE:
+			_send_window_event(WINDOW_EVENT_MOUSE_EXIT);
+			break;
+		case SDL_WINDOWEVENT_CLOSE:
+			_send_window_event(WINDOW_EVENT_CLOSE_REQUEST);
+			break;
+	}
+}
+
 void DisplayServerSDL::_process_sdl_touch_event(const SDL_Event &event) {
+	const Size2i physical = _rotate_size(window_size);
+	const Vector2 pos = _physical_to_logical(Vector2(event.tfinger.x * physical.width, event.tfinger.y * physical.height));
+
 	switch (event.type) {
 		case SDL_FINGERDOWN: {
+			int index = touch_gestures.touch_down(event.tfinger.fingerId, pos);
+			if (index < 0) {
+				break;
+			}
 			Ref<InputEventScreenTouch> touch;
 			touch.instantiate();
-			int win_w = 0, win_h = 0;
-			SDL_GetWindowSize(window, &win_w, &win_h);
-			Vector2 pos(event.tfinger.x * win_w, event.tfinger.y * win_h);
-			touch->set_index(event.tfinger.fingerId);
+			touch->set_index(index);
 			touch->set_position(pos);
 			touch->set_pressed(true);
 			inputHandler->parse_input_event(touch);
 			break;
 		}
 		case SDL_FINGERUP: {
+			int index = touch_gestures.touch_up(event.tfinger.fingerId);
+			if (index < 0) {
+				break;
+			}
 			Ref<InputEventScreenTouch> touch;
 			touch.instantiate();
-			int win_w = 0, win_h = 0;
-			SDL_GetWindowSize(window, &win_w, &win_h);
-			Vector2 pos(event.tfinger.x * win_w, event.tfinger.y * win_h);
-			touch->set_index(event.tfinger.fingerId);
+			touch->set_index(index);
 			touch->set_position(pos);
 			touch->set_pressed(false);
 			inputHandler->parse_input_event(touch);
 			break;
 		}
 		case SDL_FINGERMOTION: {
+			int index = touch_gestures.touch_move(event.tfinger.fingerId, pos);
+			if (index < 0) {
+				break;
+			}
+			if (touch_gestures_enabled && touch_gestures_consume_drag && touch_gestures.is_gesture_active()) {
+				break; // The gesture events replace the raw drag stream.
+			}
 			Ref<InputEventScreenDrag> drag;
 			drag.instantiate();
-			int win_w = 0, win_h = 0;
-			SDL_GetWindowSize(window, &win_w, &win_h);
-			Vector2 pos(event.tfinger.x * win_w, event.tfinger.y * win_h);
-			Vector2 rel(event.tfinger.dx * win_w, event.tfinger.dy * win_h);
-			drag->set_index(event.tfinger.fingerId);
+			Vector2 rel = _physical_to_logical_relative(Vector2(event.tfinger.dx * physical.width, event.tfinger.dy * physical.height));
+			drag->set_index(index);
 			drag->set_position(pos);
 			drag->set_relative(rel);
 			drag->set_pressure(event.tfinger.pressure);
@@ -923,6 +1532,30 @@ void DisplayServerSDL::_process_sdl_touch_event(const SDL_Event &event) {
 	}
 }
 
+void DisplayServerSDL::_flush_touch_gestures() {
+	TouchGestureRecognizerSDL::Gesture gesture;
+	if (!touch_gestures.flush(gesture) || !touch_gestures_enabled) {
+		return;
+	}
+
+	if (gesture.magnify) {
+		Ref<InputEventMagnifyGesture> magnify;
+		magnify.instantiate();
+		magnify->set_window_id(MAIN_WINDOW_ID);
+		magnify->set_position(gesture.center);
+		magnify->set_factor(gesture.magnify_factor);
+		inputHandler->parse_input_event(magnify);
+	}
+	if (gesture.pan) {
+		Ref<InputEventPanGesture> pan;
+		pan.instantiate();
+		pan->set_window_id(MAIN_WINDOW_ID);
+		pan->set_position(gesture.center);
+		pan->set_delta(gesture.pan_delta);
+		inputHandler->parse_input_event(pan);
+	}
+}
+
 void DisplayServerSDL::_process_sdl_joystick_event(const SDL_Event &event) {
 	// avoid processing events from GameControllers
 	SDL_JoystickID joystick_instance_id = 0;
@@ -937,10 +1570,6 @@ void DisplayServerSDL::_process_sdl_joystick_event(const SDL_Event &event) {
 		case SDL_JOYHATMOTION:
 			joystick_instance_id = event.jhat.which;
 			break;
-		case SDL_JOYDEVICEADDED:
-		case SDL_CONTROLLERDEVICEADDED:
-			// handled below
-			break;
 		default:
 			return;
 	}
@@ -1001,26 +1630,6 @@ void DisplayServerSDL::_process_sdl_joystick_event(const SDL_Event &event) {
 			}
 			break;
 		}
-		case SDL_JOYDEVICEADDED: {
-			// ADAPTADO: Solo abrir Joystick si NO es GameController
-			int idx = event.jdevice.which;
-			if (!SDL_IsGameController(idx)) {
-				SDL_JoystickOpen(idx);
-			}
-			break;
-		}
-		case SDL_CONTROLLERDEVICEADDED: {
-			// ADAPTADO: Abrir GameController y registrar el ID
-			int idx = event.cdevice.which;
-			if (SDL_IsGameController(idx)) {
-				SDL_GameController *gc = SDL_GameControllerOpen(idx);
-				if (gc) {
-					SDL_JoystickID id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(gc));
-					gamecontroller_ids.insert(id);
-				}
-			}
-			break;
-		}
 	}
 }
 
@@ -1053,56 +1662,180 @@ void DisplayServerSDL::_process_sdl_gamecontroller_event(const SDL_Event &event)
 			inputHandler->parse_input_event(button);
 			break;
 		}
-		case SDL_CONTROLLERDEVICEADDED: {
-			// Open and register the GameController
-			int idx = event.cdevice.which;
-			if (SDL_IsGameController(idx)) {
-				SDL_GameController *gc = SDL_GameControllerOpen(idx);
-				if (gc) {
-					SDL_JoystickID id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(gc));
-					gamecontroller_ids.insert(id); // Register to avoid double handling
-				}
-			}
+		case SDL_CONTROLLERDEVICEREMAPPED: {
+			print_line("DisplayServerSDL: GameController remapped");
 			break;
 		}
-		case SDL_CONTROLLERDEVICEREMOVED: {
-			// clear registration and close the GameController
-			SDL_JoystickID id = event.cdevice.which;
-			if (gamecontroller_ids.count(id)) {
-				gamecontroller_ids.erase(id);
-				SDL_GameController *gc = SDL_GameControllerFromInstanceID(id);
-				if (gc) {
-					SDL_GameControllerClose(gc);
-					print_line("DisplayServerSDL: GameController closed and removed, ID: " + String::num(id));
-				}
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+		case SDL_CONTROLLERSENSORUPDATE: {
+			auto it = controller_sensors.find(event.csensor.which);
+			if (it == controller_sensors.end()) {
+				break;
+			}
+#if SDL_VERSION_ATLEAST(2, 26, 0)
+			uint64_t timestamp_us = event.csensor.timestamp_us ? event.csensor.timestamp_us : uint64_t(event.csensor.timestamp) * 1000;
+#else
+			uint64_t timestamp_us = uint64_t(event.csensor.timestamp) * 1000;
+#endif
+			if (event.csensor.sensor == SDL_SENSOR_ACCEL) {
+				it->second.accel.push(timestamp_us, event.csensor.data);
+			} else if (event.csensor.sensor == SDL_SENSOR_GYRO) {
+				it->second.gyro.push(timestamp_us, event.csensor.data);
 			}
 			break;
 		}
-		case SDL_CONTROLLERDEVICEREMAPPED: {
-			print_line("DisplayServerSDL: GameController remapped");
-			break;
-		}
+#endif
+	}
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+void DisplayServerSDL::SensorRing::push(uint64_t p_timestamp_us, const float *p_data) {
+	Sample &sample = samples[head];
+	sample.timestamp_us = p_timestamp_us;
+	sample.data[0] = p_data[0];
+	sample.data[1] = p_data[1];
+	sample.data[2] = p_data[2];
+	head = (head + 1) % CAPACITY;
+	if (count < CAPACITY) {
+		count++; // Once full, the oldest sample is overwritten.
+	}
+}
+
+PackedFloat32Array DisplayServerSDL::SensorRing::drain() {
+	PackedFloat32Array out;
+	if (count == 0) {
+		return out;
+	}
+	out.resize(count * 4);
+	float *w = out.ptrw();
+
+	uint32_t idx = (head + CAPACITY - count) % CAPACITY;
+	uint64_t prev = last_timestamp_us ? last_timestamp_us : samples[idx].timestamp_us;
+	for (uint32_t i = 0; i < count; i++) {
+		const Sample &sample = samples[idx];
+		// Deltas keep microsecond precision in float32, absolute timestamps would not.
+		w[i * 4 + 0] = (sample.timestamp_us - prev) / 1000000.0f;
+		w[i * 4 + 1] = sample.data[0];
+		w[i * 4 + 2] = sample.data[1];
+		w[i * 4 + 3] = sample.data[2];
+		prev = sample.timestamp_us;
+		idx = (idx + 1) % CAPACITY;
+	}
+	last_timestamp_us = prev;
+	count = 0;
+	return out;
+}
+#endif
+
+PackedFloat32Array DisplayServerSDL::joy_get_sensor_samples(int p_device, JoySensor p_sensor) {
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+	auto it = controller_sensors.find(p_device);
+	if (it != controller_sensors.end()) {
+		return p_sensor == JOY_SENSOR_GYROSCOPE ? it->second.gyro.drain() : it->second.accel.drain();
+	}
+#endif
+	return PackedFloat32Array();
+}
+
+bool DisplayServerSDL::joy_has_sensor(int p_device, JoySensor p_sensor) const {
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+	auto it = controller_sensors.find(p_device);
+	if (it != controller_sensors.end()) {
+		return p_sensor == JOY_SENSOR_GYROSCOPE ? it->second.gyro.enabled : it->second.accel.enabled;
 	}
+#endif
+	return false;
 }
 
-// When a device is added (either GameController or Joystick)
+void DisplayServerSDL::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("joy_get_sensor_samples", "device", "sensor"), &DisplayServerSDL::joy_get_sensor_samples);
+	ClassDB::bind_method(D_METHOD("joy_has_sensor", "device", "sensor"), &DisplayServerSDL::joy_has_sensor);
+
+	ClassDB::bind_method(D_METHOD("get_fullscreen_display_modes", "screen"), &DisplayServerSDL::get_fullscreen_display_modes, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("set_fullscreen_display_mode", "size", "refresh_rate"), &DisplayServerSDL::set_fullscreen_display_mode, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_fullscreen_display_mode_size"), &DisplayServerSDL::get_fullscreen_display_mode_size);
+
+	ClassDB::bind_method(D_METHOD("present_add_damage", "rects"), &DisplayServerSDL::present_add_damage);
+
+	ClassDB::bind_method(D_METHOD("frame_capture_start", "path", "ring_size"), &DisplayServerSDL::frame_capture_start, DEFVAL(String()), DEFVAL(3));
+	ClassDB::bind_method(D_METHOD("frame_capture_stop"), &DisplayServerSDL::frame_capture_stop);
+
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_scale"), &DisplayServerSDL::get_dynamic_resolution_scale);
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_log"), &DisplayServerSDL::get_dynamic_resolution_log);
+
+	BIND_ENUM_CONSTANT(JOY_SENSOR_ACCELEROMETER);
+	BIND_ENUM_CONSTANT(JOY_SENSOR_GYROSCOPE);
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+void DisplayServerSDL::_enable_controller_sensors(SDL_GameController *p_controller, SDL_JoystickID p_id) {
+	if (!controller_sensors_enabled) {
+		return;
+	}
+
+	bool has_accel = SDL_GameControllerHasSensor(p_controller, SDL_SENSOR_ACCEL);
+	bool has_gyro = SDL_GameControllerHasSensor(p_controller, SDL_SENSOR_GYRO);
+	if (!has_accel && !has_gyro) {
+		return;
+	}
+
+	ControllerSensors &sensors = controller_sensors[p_id];
+	if (has_accel) {
+		sensors.accel.enabled = SDL_GameControllerSetSensorEnabled(p_controller, SDL_SENSOR_ACCEL, SDL_TRUE) == 0;
+	}
+	if (has_gyro) {
+		sensors.gyro.enabled = SDL_GameControllerSetSensorEnabled(p_controller, SDL_SENSOR_GYRO, SDL_TRUE) == 0;
+	}
+	print_line("GameController sensors enabled, ID: ", p_id, " accel: ", sensors.accel.enabled, " gyro: ", sensors.gyro.enabled);
+}
+#endif
+
+// When a device is added (either GameController or Joystick).
+// Opening stays on the main thread: SDL holds SDL_LockJoysticks for the whole
+// open and SDL_PollEvent needs the same lock, so a worker would only move the
+// stall. The time spent is logged so slow pads show up.
 void DisplayServerSDL::_handle_device_added(int device_index) {
-	if (SDL_IsGameController(device_index)) {
+	// SDL also reports pads present at startup as added; skip those already open.
+	SDL_JoystickID id = SDL_JoystickGetDeviceInstanceID(device_index);
+	if (id < 0 || controllers.count(id) || joysticks.count(id)) {
+		return;
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	char guid[33] = {};
+	SDL_JoystickGetGUIDString(SDL_JoystickGetDeviceGUID(device_index), guid, sizeof(guid));
+
+	const char *name = nullptr;
+	bool is_controller = SDL_IsGameController(device_index);
+	if (is_controller) {
 		SDL_GameController *gc = SDL_GameControllerOpen(device_index);
-		if (gc) {
-			SDL_JoystickID id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(gc));
-			gamecontroller_ids.insert(id);
-			controllers[id] = gc;
-			print_line("GameController connected, ID: ", id);
+		if (!gc) {
+			fprintf(stderr, "Could not open game controller %d, Error: %s\n", device_index, SDL_GetError());
+			return;
 		}
+		id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(gc));
+		name = SDL_GameControllerName(gc);
+		gamecontroller_ids.insert(id);
+		controllers[id] = gc;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+		_enable_controller_sensors(gc, id);
+#endif
 	} else {
 		SDL_Joystick *joy = SDL_JoystickOpen(device_index);
-		if (joy) {
-			SDL_JoystickID id = SDL_JoystickInstanceID(joy);
-			joysticks[id] = joy;
-			print_line("Joystick connected, ID: ", id);
+		if (!joy) {
+			fprintf(stderr, "Could not open joystick %d, Error: %s\n", device_index, SDL_GetError());
+			return;
 		}
+		id = SDL_JoystickInstanceID(joy);
+		name = SDL_JoystickName(joy);
+		joysticks[id] = joy;
 	}
+
+	String device_name = String::utf8(name ? name : "Unknown");
+	double open_msec = (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+	print_line(is_controller ? "GameController" : "Joystick", " connected, ID: ", id, " (", device_name, "), open took ", open_msec, " ms");
+
+	inputHandler->joy_connection_changed(id, true, device_name, String(guid));
 }
 
 // When a device is disconnected
@@ -1115,16 +1848,22 @@ void DisplayServerSDL::_handle_device_removed(SDL_JoystickID joystick_instance_i
 			controllers.erase(it);
 		}
 		gamecontroller_ids.erase(joystick_instance_id);
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+		controller_sensors.erase(joystick_instance_id);
+#endif
 		print_line("GameController disconnected, ID: ", joystick_instance_id);
 	} else {
 		// It's a classic Joystick
 		auto it = joysticks.find(joystick_instance_id);
-		if (it != joysticks.end()) {
-			SDL_JoystickClose(it->second);
-			joysticks.erase(it);
+		if (it == joysticks.end()) {
+			return; // Never opened.
 		}
+		SDL_JoystickClose(it->second);
+		joysticks.erase(it);
 		print_line("Joystick disconnected, ID: ", joystick_instance_id);
 	}
+
+	inputHandler->joy_connection_changed(joystick_instance_id, false, "");
 }
 
 int DisplayServerSDL::get_sdl_swap_interval(DisplayServer::VSyncMode p_vsync_mode) {
@@ -1136,7 +1875,9 @@ int DisplayServerSDL::get_sdl_swap_interval(DisplayServer::VSyncMode p_vsync_mod
 		case DisplayServer::VSYNC_ADAPTIVE:
 			return -1;
 		case DisplayServer::VSYNC_MAILBOX:
-			return -2;
+			// EGL can't replace a queued frame at vblank, so like the other GL
+			// backends treat mailbox as plain VSync rather than let it tear.
+			return 1;
 		default:
 			return 0;
 	}
@@ -1150,7 +1891,7 @@ Point2i DisplayServerSDL::mouse_get_position() const {
 
 	int mouse_x, mouse_y;
 	SDL_GetMouseState(&mouse_x, &mouse_y);
-	return Point2i(mouse_x, mouse_y);
+	return Point2i(_physical_to_logical(Vector2(mouse_x, mouse_y)));
 }
 
 void DisplayServerSDL::mouse_set_mode(MouseMode p_mode) {
@@ -1158,4 +1899,171 @@ void DisplayServerSDL::mouse_set_mode(MouseMode p_mode) {
 		return;
 	}
 	SDL_SetRelativeMouseMode(p_mode == MOUSE_MODE_CAPTURED ? SDL_TRUE : SDL_FALSE);
+}
+
+// SDL has fewer system cursors than Godot; the closest match is used.
+static const SDL_SystemCursor sdl_system_cursors[DisplayServer::CURSOR_MAX] = {
+	SDL_SYSTEM_CURSOR_ARROW, // CURSOR_ARROW
+	SDL_SYSTEM_CURSOR_IBEAM, // CURSOR_IBEAM
+	SDL_SYSTEM_CURSOR_HAND, // CURSOR_POINTING_HAND
+	SDL_SYSTEM_CURSOR_CROSSHAIR, // CURSOR_CROSS
+	SDL_SYSTEM_CURSOR_WAIT, // CURSOR_WAIT
+	SDL_SYSTEM_CURSOR_WAITARROW, // CURSOR_BUSY
+	SDL_SYSTEM_CURSOR_HAND, // CURSOR_DRAG
+	SDL_SYSTEM_CURSOR_HAND, // CURSOR_CAN_DROP
+	SDL_SYSTEM_CURSOR_NO, // CURSOR_FORBIDDEN
+	SDL_SYSTEM_CURSOR_SIZENS, // CURSOR_VSIZE
+	SDL_SYSTEM_CURSOR_SIZEWE, // CURSOR_HSIZE
+	SDL_SYSTEM_CURSOR_SIZENESW, // CURSOR_BDIAGSIZE
+	SDL_SYSTEM_CURSOR_SIZENWSE, // CURSOR_FDIAGSIZE
+	SDL_SYSTEM_CURSOR_SIZEALL, // CURSOR_MOVE
+	SDL_SYSTEM_CURSOR_SIZENS, // CURSOR_VSPLIT
+	SDL_SYSTEM_CURSOR_SIZEWE, // CURSOR_HSPLIT
+	SDL_SYSTEM_CURSOR_ARROW, // CURSOR_HELP
+};
+
+void DisplayServerSDL::_apply_cursor() {
+	SDL_Cursor *cursor = custom_cursors[cursor_shape];
+	if (!cursor) {
+		if (!system_cursors[cursor_shape]) {
+			system_cursors[cursor_shape] = SDL_CreateSystemCursor(sdl_system_cursors[cursor_shape]);
+		}
+		cursor = system_cursors[cursor_shape];
+	}
+	if (cursor && cursor != SDL_GetCursor()) {
+		SDL_SetCursor(cursor);
+	}
+}
+
+void DisplayServerSDL::_free_cursors() {
+	for (int i = 0; i < CURSOR_MAX; i++) {
+		if (system_cursors[i]) {
+			SDL_FreeCursor(system_cursors[i]);
+			system_cursors[i] = nullptr;
+		}
+		custom_cursors[i] = nullptr;
+	}
+	for (const CustomCursor &E : custom_cursor_cache) {
+		SDL_FreeCursor(E.cursor);
+	}
+	custom_cursor_cache.clear();
+}
+
+void DisplayServerSDL::_evict_custom_cursors() {
+	while (custom_cursor_cache.size() > CUSTOM_CURSOR_CACHE_SIZE) {
+		int oldest = -1;
+		for (uint32_t i = 0; i < custom_cursor_cache.size(); i++) {
+			bool assigned = false;
+			for (int j = 0; j < CURSOR_MAX; j++) {
+				assigned = assigned || custom_cursors[j] == custom_cursor_cache[i].cursor;
+			}
+			if (!assigned && (oldest == -1 || custom_cursor_cache[i].last_used < custom_cursor_cache[oldest].last_used)) {
+				oldest = i;
+			}
+		}
+		if (oldest == -1) {
+			return; // Everything left is in use.
+		}
+		SDL_FreeCursor(custom_cursor_cache[oldest].cursor);
+		custom_cursor_cache.remove_at_unordered(oldest);
+	}
+}
+
+void DisplayServerSDL::cursor_set_shape(CursorShape p_shape) {
+	ERR_FAIL_INDEX(p_shape, CURSOR_MAX);
+	cursor_shape = p_shape;
+	_apply_cursor();
+}
+
+DisplayServer::CursorShape DisplayServerSDL::cursor_get_shape() const {
+	return cursor_shape;
+}
+
+void DisplayServerSDL::cursor_set_custom_image(const Ref<Resource> &p_cursor, CursorShape p_shape, const Vector2 &p_hotspot) {
+	ERR_FAIL_INDEX(p_shape, CURSOR_MAX);
+
+	if (p_cursor.is_null()) {
+		custom_cursors[p_shape] = nullptr;
+		if (p_shape == cursor_shape) {
+			_apply_cursor();
+		}
+		return;
+	}
+
+	Ref<Image> image = _get_cursor_image_from_resource(p_cursor, p_hotspot);
+	ERR_FAIL_COND(image.is_null());
+	if (image->get_format() != Image::FORMAT_RGBA8) {
+		image = image->duplicate();
+		image->convert(Image::FORMAT_RGBA8);
+	}
+
+	Vector<uint8_t> data = image->get_data();
+	Size2i size = image->get_size();
+	Point2i hotspot = p_hotspot;
+	uint32_t key = hash_murmur3_buffer(data.ptr(), data.size());
+	key = hash_murmur3_one_32(size.width, key);
+	key = hash_murmur3_one_32(size.height, key);
+	key = hash_murmur3_one_32(hotspot.x, key);
+	key = hash_murmur3_one_32(hotspot.y, key);
+	key = hash_murmur3_one_32(display_rotation, key);
+
+	CustomCursor *cached = nullptr;
+	for (CustomCursor &E : custom_cursor_cache) {
+		if (E.hash == key && E.size == size && E.hotspot == hotspot && E.rotation == display_rotation && E.data == data) {
+			cached = &E;
+			break;
+		}
+	}
+	if (cached) {
+		cached->last_used = ++custom_cursor_uses;
+		custom_cursors[p_shape] = cached->cursor;
+	} else {
+		CustomCursor entry;
+		entry.hash = key;
+		entry.data = data;
+		entry.size = size;
+		entry.hotspot = hotspot;
+		entry.rotation = display_rotation;
+
+		// The cursor plane isn't rotated with the frame, so the image is.
+		int width = size.width;
+		int height = size.height;
+		if (display_rotation != 0) {
+			image = image->duplicate();
+			switch (display_rotation) {
+				case 90:
+					image->rotate_90(CLOCKWISE);
+					hotspot = Point2i(height - 1 - hotspot.y, hotspot.x);
+					break;
+				case 180:
+					image->rotate_180();
+					hotspot = Point2i(width - 1 - hotspot.x, height - 1 - hotspot.y);
+					break;
+				case 270:
+					image->rotate_90(COUNTERCLOCKWISE);
+					hotspot = Point2i(hotspot.y, width - 1 - hotspot.x);
+					break;
+			}
+			data = image->get_data();
+			width = image->get_width();
+			height = image->get_height();
+		}
+
+		SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom((void *)data.ptr(), width, height, 32, width * 4, SDL_PIXELFORMAT_RGBA32);
+		ERR_FAIL_NULL_MSG(surface, "Could not create cursor surface: " + String(SDL_GetError()));
+		SDL_Cursor *cursor = SDL_CreateColorCursor(surface, hotspot.x, hotspot.y);
+		SDL_FreeSurface(surface);
+		ERR_FAIL_NULL_MSG(cursor, "Could not create custom cursor: " + String(SDL_GetError()));
+
+		entry.last_used = ++custom_cursor_uses;
+		entry.cursor = cursor;
+		custom_cursor_cache.push_back(entry);
+		custom_cursors[p_shape] = cursor;
+	}
+
+	if (p_shape == cursor_shape) {
+		_apply_cursor();
+	}
+	// After the switch, so the cursor being replaced isn't still the current one.
+	_evict_custom_cursors();
 }
\ No newline at end of file
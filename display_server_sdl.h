@@ -2,18 +2,28 @@
 
 #include "core/input/input.h"
 #include "core/input/input_event.h"
+#include "core/templates/hash_map.h"
+#include "dynamic_resolution_sbc.h"
+#include "renderer_probe_cache_sbc.h"
 #include "servers/display_server.h"
+#include "touch_gesture_recognizer_sdl.h"
 #include <SDL2/SDL.h>
 #include <set>
 #include <unordered_map>
 
 #ifdef GLES3_ENABLED
 #include "drivers/gles3/rasterizer_gles3.h"
+#include "frame_capture_sdl.h"
+#include "gl_presenter_sdl.h"
+#include "gl_proc_loader_sdl.h"
+#include "gl_rotation_blit_sdl.h"
+#include "mirror_displays_sdl.h"
 #endif
 
 #ifdef VULKAN_ENABLED
 #include "drivers/vulkan/rendering_context_driver_vulkan.h"
 #include "drivers/vulkan/rendering_device_driver_vulkan.h"
+#include "rendering_context_driver_vulkan_sdl.h"
 #include "servers/rendering/renderer_rd/renderer_compositor_rd.h"
 #include "servers/rendering/rendering_device.h"
 
@@ -31,8 +41,21 @@ private:
 	Callable input_text_callback;
 	Callable drop_files_callback;
 
+	// Window geometry and state, kept up to date from SDL_WINDOWEVENT so getters
+	// never have to round-trip into SDL.
 	Size2i window_size = Size2i(800, 600);
 	Point2i window_position = Point2i(0, 0);
+	int window_screen = 0;
+	Rect2i screen_rect;
+	bool window_focused = false;
+	bool window_visible = true;
+	bool window_minimized = false;
+
+	// Resize storms are coalesced: rect_changed_callback only runs once no
+	// geometry change has been seen for RECT_CHANGED_DEBOUNCE_MSEC.
+	static const uint64_t RECT_CHANGED_DEBOUNCE_MSEC = 30;
+	bool rect_changed_pending = false;
+	uint64_t rect_changed_ticks = 0;
 	WindowMode window_mode = WINDOW_MODE_FULLSCREEN;
 	SDL_Window *window = nullptr;
 	ObjectID instance_id;
@@ -45,20 +68,139 @@ private:
 	std::unordered_map<SDL_JoystickID, SDL_GameController *> controllers; // Optional, for direct access
 	std::unordered_map<SDL_JoystickID, SDL_Joystick *> joysticks; // For non-compatible ones
 
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+	// Controller gyro/accelerometer samples arrive at up to 1 kHz, far too many
+	// for one InputEvent each. They are kept in a fixed ring per device and
+	// drained by script once per frame through joy_get_sensor_samples().
+	struct SensorRing {
+		static const uint32_t CAPACITY = 512;
+		struct Sample {
+			uint64_t timestamp_us;
+			float data[3];
+		};
+		Sample samples[CAPACITY];
+		uint32_t head = 0; // Next slot to write.
+		uint32_t count = 0;
+		uint64_t last_timestamp_us = 0; // Newest sample already handed to script.
+		bool enabled = false;
+
+		void push(uint64_t p_timestamp_us, const float *p_data);
+		PackedFloat32Array drain();
+	};
+	struct ControllerSensors {
+		SensorRing accel;
+		SensorRing gyro;
+	};
+	std::unordered_map<SDL_JoystickID, ControllerSensors> controller_sensors;
+	bool controller_sensors_enabled = false;
+
+	void _enable_controller_sensors(SDL_GameController *p_controller, SDL_JoystickID p_id);
+#endif
+
+	DynamicResolutionSBC dynamic_resolution;
+
+	// Native pinch/pan recognition, so projects don't have to rebuild it from
+	// InputEventScreenDrag in script.
+	TouchGestureRecognizerSDL touch_gestures;
+	bool touch_gestures_enabled = true;
+	bool touch_gestures_consume_drag = false;
+
 #ifdef GLES3_ENABLED
 	SDL_GLContext gl_context = nullptr;
+
+	// With the separate render thread model the context lives on the render
+	// thread, so swap interval changes requested from the main thread are
+	// applied from swap_buffers().
+	VSyncMode vsync_mode = VSYNC_ENABLED;
+	int requested_swap_interval = 1;
+	bool requested_drop_busy_frames = false;
+	bool drop_busy_frames = false; // rendering/gl_compatibility/sbc/drop_busy_frames
+	SafeFlag swap_interval_dirty;
+
+	GLPresenterSDL gl_presenter;
+	FrameCaptureSDL frame_capture;
+	GLRotationBlitSDL gl_rotation;
+	MirrorDisplaysSDL mirror_displays;
 #endif
 
+	// SDL cursors go to the video driver's hardware cursor (a KMS cursor plane
+	// under KMSDRM), so pointer motion never needs a redraw. Converted custom
+	// cursors are cached by image contents, size, hotspot and rotation; the
+	// hash only narrows the search, entries are compared in full. Past
+	// CUSTOM_CURSOR_CACHE_SIZE the least recently used unassigned one is freed.
+	static const uint32_t CUSTOM_CURSOR_CACHE_SIZE = 16;
+	struct CustomCursor {
+		uint32_t hash = 0;
+		Vector<uint8_t> data;
+		Size2i size;
+		Point2i hotspot;
+		int rotation = 0;
+		uint64_t last_used = 0;
+		SDL_Cursor *cursor = nullptr;
+	};
+	CursorShape cursor_shape = CURSOR_ARROW;
+	SDL_Cursor *system_cursors[CURSOR_MAX] = {};
+	SDL_Cursor *custom_cursors[CURSOR_MAX] = {};
+	LocalVector<CustomCursor> custom_cursor_cache;
+	uint64_t custom_cursor_uses = 0;
+
+	// Fullscreen output mode. A size of zero keeps the previous behaviour
+	// (the window's own size); otherwise the closest display mode is used so
+	// the display does the upscaling. Modes are enumerated once per screen
+	// and re-resolved on SDL_DISPLAYEVENT or when the window changes screen.
+	Size2i fullscreen_size;
+	int fullscreen_refresh_rate = 0;
+	int display_modes_screen = -1;
+	LocalVector<SDL_DisplayMode> display_modes;
+	bool fullscreen_mode_valid = false;
+	SDL_DisplayMode fullscreen_mode = {};
+	SDL_DisplayMode applied_mode = {};
+
+	// Clockwise panel rotation in degrees. window_size and screen sizes are
+	// logical (already rotated); SDL deals in physical coordinates.
+	int display_rotation = 0;
+
 #ifdef VULKAN_ENABLED
 	VkInstance vk_instance = VK_NULL_HANDLE;
 	VkSurfaceKHR vk_surface = VK_NULL_HANDLE;
-	RenderingContextDriverVulkan *vulkan_context = nullptr;
+	RenderingContextDriverVulkanSDL *vulkan_context = nullptr;
 	RenderingDevice *rendering_device = nullptr;
 	uint64_t vulkan_surface_id = 0;
+	uint64_t vulkan_probe_usec = 0;
 #endif
 
+	RendererProbeCacheSBC renderer_probe_cache;
+
 	void _destroy_window();
 
+protected:
+	static void _bind_methods();
+
+private:
+	void _update_window_cache();
+	// Returns true if the window moved to another screen (display modes are then already re-resolved).
+	bool _update_screen_cache();
+	void _send_window_event(WindowEvent p_event);
+	void _flush_rect_changed();
+	void _update_dynamic_resolution();
+	bool _is_mirror_window(Uint32 p_window_id) const;
+	void _probe_texture_formats();
+#ifdef VULKAN_ENABLED
+	void _resize_vulkan_surface();
+#endif
+	const LocalVector<SDL_DisplayMode> &_get_display_modes(int p_screen);
+	void _update_fullscreen_mode();
+	void _reset_display_modes();
+	void _apply_cursor();
+	void _free_cursors();
+	void _evict_custom_cursors();
+	Size2i _rotate_size(const Size2i &p_size) const;
+	Vector2 _physical_to_logical(const Vector2 &p_point) const;
+	Vector2 _physical_to_logical_relative(const Vector2 &p_relative) const;
+#ifdef GLES3_ENABLED
+	void _print_gl_framebuffer_config();
+#endif
+
 public:
 	//SDL_Window *get_window();
 	DisplayServerSDL(const String &p_rendering_driver, WindowMode p_mode, VSyncMode p_vsync, uint32_t p_flags, const Point2i *p_position, const Size2i &p_resolution, int p_screen, Context p_context, int64_t p_parent_window, Error &r_error);
@@ -86,6 +228,9 @@ public:
 	WindowMode window_get_mode(WindowID p_window = MAIN_WINDOW_ID) const override;
 
 	virtual void swap_buffers() override;
+	virtual void release_rendering_thread() override;
+	virtual void gl_window_make_current(DisplayServer::WindowID p_window_id) override;
+	virtual void gl_window_release_current() override;
 	virtual void window_set_vsync_mode(VSyncMode p_vsync_mode, WindowID p_window = MAIN_WINDOW_ID) override;
 	virtual VSyncMode window_get_vsync_mode(WindowID p_window) const override;
 	int get_sdl_swap_interval(VSyncMode mode);
@@ -138,10 +283,36 @@ public:
 
 	virtual float screen_get_refresh_rate(int p_screen = SCREEN_OF_MAIN_WINDOW) const override;
 
+	enum JoySensor {
+		JOY_SENSOR_ACCELEROMETER,
+		JOY_SENSOR_GYROSCOPE,
+	};
+
+	// Returns the samples buffered since the last call as [dt, x, y, z] quads,
+	// dt being seconds since the previous sample.
+	PackedFloat32Array joy_get_sensor_samples(int p_device, JoySensor p_sensor);
+	bool joy_has_sensor(int p_device, JoySensor p_sensor) const;
+
+	TypedArray<Dictionary> get_fullscreen_display_modes(int p_screen = -1);
+	void set_fullscreen_display_mode(const Vector2i &p_size, int p_refresh_rate = 0);
+	Vector2i get_fullscreen_display_mode_size() const;
+
+	void present_add_damage(const TypedArray<Rect2i> &p_rects);
+
+	Error frame_capture_start(const String &p_path = String(), int p_ring_size = 3);
+	void frame_capture_stop();
+
+	float get_dynamic_resolution_scale() const;
+	PackedStringArray get_dynamic_resolution_log() const;
+
 	// Mouse handling
 	virtual Point2i mouse_get_position() const override;
 	virtual void mouse_set_mode(MouseMode p_mode) override;
 
+	virtual void cursor_set_shape(CursorShape p_shape) override;
+	virtual CursorShape cursor_get_shape() const override;
+	virtual void cursor_set_custom_image(const Ref<Resource> &p_cursor, CursorShape p_shape = CURSOR_ARROW, const Vector2 &p_hotspot = Vector2()) override;
+
 	// Constructor/destructor
 	static DisplayServer *create_func(const String &p_rendering_driver, WindowMode p_mode, VSyncMode p_vsync, uint32_t p_flags, const Point2i *p_position, const Size2i &p_resolution, int p_screen, Context p_context, int64_t p_parent_window, Error &r_error);
 	static Vector<String> get_rendering_drivers_func();
@@ -154,7 +325,9 @@ public:
 	void _process_sdl_key_event(const SDL_KeyboardEvent &key_event);
 	void _process_sdl_mouse_event(const SDL_Event &mouse_event);
 	void _process_sdl_text_input(const SDL_TextInputEvent &text_event);
+	void _process_sdl_window_event(const SDL_WindowEvent &window_event);
 	void _process_sdl_touch_event(const SDL_Event &event);
+	void _flush_touch_gestures();
 	void _process_sdl_joystick_event(const SDL_Event &event);
 	void _process_sdl_gamecontroller_event(const SDL_Event &event);
 	void _handle_device_added(int device_index);
@@ -168,12 +341,5 @@ public:
 #endif
 };
 
-#ifdef GLES3_ENABLED
-static void *get_gl_proc_address(const char *p_name) {
-	void *ptr = SDL_GL_GetProcAddress(p_name);
-	if (!ptr) {
-		printf("GLAD/SDL: Cannot load function: %s\n", p_name);
-	}
-	return ptr;
-}
-#endif
\ No newline at end of file
+VARIANT_ENUM_CAST(DisplayServerSDL::JoySensor);
+
@@ -0,0 +1,189 @@
+#include "dynamic_resolution_sbc.h"
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+
+#ifdef GLES3_ENABLED
+#include "platform_gl.h"
+
+#include <SDL2/SDL.h>
+
+#ifndef GL_TIME_ELAPSED_EXT
+#define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT_EXT
+#define GL_QUERY_RESULT_EXT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE_EXT
+#define GL_QUERY_RESULT_AVAILABLE_EXT 0x8867
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+// GL_EXT_disjoint_timer_query entry points, resolved on first use.
+typedef void (*PFN_SBC_GenQueries)(GLsizei, GLuint *);
+typedef void (*PFN_SBC_DeleteQueries)(GLsizei, const GLuint *);
+typedef void (*PFN_SBC_BeginQuery)(GLenum, GLuint);
+typedef void (*PFN_SBC_EndQuery)(GLenum);
+typedef void (*PFN_SBC_GetQueryObjectuiv)(GLuint, GLenum, GLuint *);
+typedef void (*PFN_SBC_GetQueryObjectui64v)(GLuint, GLenum, GLuint64 *);
+
+static PFN_SBC_GenQueries sbc_glGenQueriesEXT = nullptr;
+static PFN_SBC_DeleteQueries sbc_glDeleteQueriesEXT = nullptr;
+static PFN_SBC_BeginQuery sbc_glBeginQueryEXT = nullptr;
+static PFN_SBC_EndQuery sbc_glEndQueryEXT = nullptr;
+static PFN_SBC_GetQueryObjectuiv sbc_glGetQueryObjectuivEXT = nullptr;
+static PFN_SBC_GetQueryObjectui64v sbc_glGetQueryObjectui64vEXT = nullptr;
+#endif // GLES3_ENABLED
+
+void DynamicResolutionSBC::configure(bool p_enabled, float p_min_scale, float p_max_scale, float p_step, int p_hysteresis_frames, float p_target_fps) {
+	enabled = p_enabled;
+	min_scale = CLAMP(p_min_scale, 0.25f, 1.0f);
+	max_scale = CLAMP(p_max_scale, min_scale, 2.0f);
+	step = MAX(p_step, 0.01f);
+	hysteresis_frames = MAX(p_hysteresis_frames, 1);
+	budget_usec = uint64_t(1000000.0 / (p_target_fps > 0.0f ? p_target_fps : 60.0f));
+	scale = max_scale;
+
+	if (enabled) {
+		print_line("Dynamic resolution enabled: scale ", min_scale, "-", max_scale, ", budget ", budget_usec, " usec");
+	}
+}
+
+#ifdef GLES3_ENABLED
+void DynamicResolutionSBC::gpu_frame_end() {
+	if (!enabled) {
+		return;
+	}
+
+	if (!gpu_timer_checked) {
+		gpu_timer_checked = true;
+		if (SDL_GL_ExtensionSupported("GL_EXT_disjoint_timer_query")) {
+			sbc_glGenQueriesEXT = (PFN_SBC_GenQueries)SDL_GL_GetProcAddress("glGenQueriesEXT");
+			sbc_glDeleteQueriesEXT = (PFN_SBC_DeleteQueries)SDL_GL_GetProcAddress("glDeleteQueriesEXT");
+			sbc_glBeginQueryEXT = (PFN_SBC_BeginQuery)SDL_GL_GetProcAddress("glBeginQueryEXT");
+			sbc_glEndQueryEXT = (PFN_SBC_EndQuery)SDL_GL_GetProcAddress("glEndQueryEXT");
+			sbc_glGetQueryObjectuivEXT = (PFN_SBC_GetQueryObjectuiv)SDL_GL_GetProcAddress("glGetQueryObjectuivEXT");
+			sbc_glGetQueryObjectui64vEXT = (PFN_SBC_GetQueryObjectui64v)SDL_GL_GetProcAddress("glGetQueryObjectui64vEXT");
+			gpu_timer_supported = sbc_glGenQueriesEXT && sbc_glDeleteQueriesEXT && sbc_glBeginQueryEXT && sbc_glEndQueryEXT && sbc_glGetQueryObjectuivEXT && sbc_glGetQueryObjectui64vEXT;
+		}
+		if (gpu_timer_supported) {
+			sbc_glGenQueriesEXT(QUERY_COUNT, queries);
+		}
+		print_line("Dynamic resolution timing source: ", gpu_timer_supported ? "GL_EXT_disjoint_timer_query" : "CPU frame cost");
+	}
+	if (!gpu_timer_supported) {
+		return;
+	}
+
+	if (query_active) {
+		sbc_glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+		query_pending[query_index] = true;
+		query_active = false;
+		query_index = (query_index + 1) % QUERY_COUNT;
+	}
+
+	// Collect finished results without ever stalling on the GPU.
+	GLint disjoint = 0;
+	glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		if (!query_pending[i]) {
+			continue;
+		}
+		GLuint available = 0;
+		sbc_glGetQueryObjectuivEXT(queries[i], GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+		if (!available) {
+			continue;
+		}
+		GLuint64 elapsed_ns = 0;
+		sbc_glGetQueryObjectui64vEXT(queries[i], GL_QUERY_RESULT_EXT, &elapsed_ns);
+		query_pending[i] = false;
+		if (!disjoint) {
+			gpu_frame_usec.set(elapsed_ns / 1000);
+		}
+	}
+}
+
+void DynamicResolutionSBC::gpu_frame_begin() {
+	if (!enabled || !gpu_timer_supported || query_pending[query_index]) {
+		return; // Slot still in flight, skip timing this frame.
+	}
+	sbc_glBeginQueryEXT(GL_TIME_ELAPSED_EXT, queries[query_index]);
+	query_active = true;
+}
+
+void DynamicResolutionSBC::gpu_release() {
+	if (gpu_timer_supported) {
+		if (query_active) {
+			sbc_glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+			query_active = false;
+		}
+		sbc_glDeleteQueriesEXT(QUERY_COUNT, queries);
+		gpu_timer_supported = false;
+	}
+}
+#endif // GLES3_ENABLED
+
+void DynamicResolutionSBC::_log(const String &p_entry) {
+	decision_log[log_next] = p_entry;
+	log_next = (log_next + 1) % LOG_SIZE;
+	log_count = MIN(log_count + 1, LOG_SIZE);
+	print_verbose("Dynamic resolution: " + p_entry);
+}
+
+bool DynamicResolutionSBC::update(uint64_t p_cpu_frame_usec) {
+	if (!enabled) {
+		return false;
+	}
+
+	// The slower of the two processors is the one bounding the frame rate.
+	uint64_t gpu_sample = gpu_frame_usec.get();
+	uint64_t sample = MAX(p_cpu_frame_usec, gpu_sample);
+	frame_usec = frame_usec == 0.0f ? sample : frame_usec * 0.9f + sample * 0.1f;
+	cpu_usec = cpu_usec == 0.0f ? p_cpu_frame_usec : cpu_usec * 0.9f + p_cpu_frame_usec * 0.1f;
+	gpu_usec = gpu_usec == 0.0f ? gpu_sample : gpu_usec * 0.9f + gpu_sample * 0.1f;
+
+	// The timer query spans swap to swap, so it also counts the GPU sitting idle
+	// while the CPU builds the frame. Only when it runs clearly past the CPU
+	// cost is the GPU the bottleneck; otherwise fewer pixels wouldn't help.
+	bool gpu_bound = gpu_sample == 0 || gpu_usec > cpu_usec * GPU_BOUND_RATIO;
+
+	if (frame_usec > budget_usec && gpu_bound) {
+		over_frames++;
+		under_frames = 0;
+	} else if (frame_usec < budget_usec * 0.75f) {
+		// Only scale back up with clear headroom, otherwise it oscillates.
+		under_frames++;
+		over_frames = 0;
+	} else {
+		over_frames = 0;
+		under_frames = 0;
+	}
+
+	float new_scale = scale;
+	if (over_frames >= hysteresis_frames) {
+		new_scale = MAX(scale - step, min_scale);
+	} else if (under_frames >= hysteresis_frames * 2) {
+		new_scale = MIN(scale + step, max_scale);
+	}
+	if (new_scale == scale) {
+		return false;
+	}
+
+	_log(vformat("%d ms: frame %.2f ms (CPU %.2f, GPU %.2f) vs budget %.2f ms, scale %.2f -> %.2f",
+			OS::get_singleton()->get_ticks_msec(), frame_usec / 1000.0f, cpu_usec / 1000.0f, gpu_usec / 1000.0f, budget_usec / 1000.0f, scale, new_scale));
+	scale = new_scale;
+	over_frames = 0;
+	under_frames = 0;
+	return true;
+}
+
+PackedStringArray DynamicResolutionSBC::get_log() const {
+	PackedStringArray log;
+	int first = (log_next + LOG_SIZE - log_count) % LOG_SIZE;
+	for (int i = 0; i < log_count; i++) {
+		log.push_back(decision_log[(first + i) % LOG_SIZE]);
+	}
+	return log;
+}
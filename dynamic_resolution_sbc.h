@@ -0,0 +1,71 @@
+#ifndef DYNAMIC_RESOLUTION_SBC_H
+#define DYNAMIC_RESOLUTION_SBC_H
+
+#include "core/templates/safe_refcount.h"
+#include "core/variant/variant.h"
+
+// Adjusts the root viewport's 3D render scale between configurable bounds so
+// the frame rate holds when scenes get heavy. Frame cost comes from
+// GL_EXT_disjoint_timer_query when the driver has it (sampled around each
+// present on the rendering thread), otherwise from the CPU frame cost
+// measured by the frame pacer. Decisions are taken on the main thread with
+// hysteresis: the scale only moves after a full window of frames agrees.
+// With GPU timing, frames over budget only lower the scale while the GPU
+// time clearly exceeds the CPU time, so CPU-bound scenes keep full resolution.
+class DynamicResolutionSBC {
+public:
+	static const int LOG_SIZE = 32;
+
+private:
+	bool enabled = false;
+	float min_scale = 0.5f;
+	float max_scale = 1.0f;
+	float step = 0.05f;
+	int hysteresis_frames = 30;
+	uint64_t budget_usec = 16667;
+
+	float scale = 1.0f;
+	float frame_usec = 0.0f; // Smoothed.
+	float cpu_usec = 0.0f; // Smoothed.
+	float gpu_usec = 0.0f; // Smoothed, swap to swap.
+	static constexpr float GPU_BOUND_RATIO = 1.1f;
+	int over_frames = 0;
+	int under_frames = 0;
+
+	String decision_log[LOG_SIZE];
+	int log_next = 0;
+	int log_count = 0;
+
+#ifdef GLES3_ENABLED
+	// GPU timing, only touched from the thread owning the GL context.
+	static const int QUERY_COUNT = 4;
+	bool gpu_timer_checked = false;
+	bool gpu_timer_supported = false;
+	uint32_t queries[QUERY_COUNT] = {};
+	bool query_pending[QUERY_COUNT] = {};
+	int query_index = 0;
+	bool query_active = false;
+#endif
+	SafeNumeric<uint64_t> gpu_frame_usec;
+
+	void _log(const String &p_entry);
+
+public:
+	void configure(bool p_enabled, float p_min_scale, float p_max_scale, float p_step, int p_hysteresis_frames, float p_target_fps);
+	bool is_enabled() const { return enabled; }
+
+#ifdef GLES3_ENABLED
+	// Rendering thread, around SDL_GL_SwapWindow.
+	void gpu_frame_end();
+	void gpu_frame_begin();
+	void gpu_release();
+#endif
+
+	// Main thread, once per frame. Returns true when the scale changed.
+	bool update(uint64_t p_cpu_frame_usec);
+
+	float get_scale() const { return scale; }
+	PackedStringArray get_log() const;
+};
+
+#endif // DYNAMIC_RESOLUTION_SBC_H
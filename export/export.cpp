@@ -0,0 +1,19 @@
+#include "export.h"
+
+#include "export_plugin.h"
+
+#include "editor/export/editor_export.h"
+
+void register_sbc_exporter_types() {
+	GDREGISTER_VIRTUAL_CLASS(EditorExportPlatformSBC);
+}
+
+void register_sbc_exporter() {
+	Ref<EditorExportPlatformSBC> platform;
+	platform.instantiate();
+	platform->set_name("SBC");
+	platform->set_os_name("SBC");
+	platform->set_chmod_flags(0755);
+
+	EditorExport::get_singleton()->add_export_platform(platform);
+}
@@ -0,0 +1,7 @@
+#ifndef SBC_EXPORT_H
+#define SBC_EXPORT_H
+
+void register_sbc_exporter_types();
+void register_sbc_exporter();
+
+#endif // SBC_EXPORT_H
@@ -0,0 +1,152 @@
+#include "export_plugin.h"
+
+#include "logo_svg.gen.h"
+#include "run_icon_svg.gen.h"
+
+#include "core/io/file_access.h"
+#include "editor/editor_node.h"
+#include "editor/editor_string_names.h"
+#include "editor/themes/editor_scale.h"
+
+#include "modules/modules_enabled.gen.h" // For svg.
+#ifdef MODULE_SVG_ENABLED
+#include "modules/svg/image_loader_svg.h"
+#endif
+
+void EditorExportPlatformSBC::get_export_options(List<ExportOption> *r_options) const {
+	EditorExportPlatformPC::get_export_options(r_options);
+
+	// SBC GPUs (Mali, VideoCore, PowerVR) sample ETC2/ASTC, almost never S3TC/BPTC.
+	// Leaving the desktop variants off keeps them out of the pack entirely.
+	for (ExportOption &option : *r_options) {
+		if (option.option.name == "texture_format/etc2_astc") {
+			option.default_value = true;
+		} else if (option.option.name == "texture_format/s3tc_bptc") {
+			option.default_value = false;
+		}
+	}
+
+	r_options->push_back(ExportOption(PropertyInfo(Variant::STRING, "binary_format/architecture", PROPERTY_HINT_ENUM, "arm64,arm32,x86_64"), "arm64"));
+}
+
+List<String> EditorExportPlatformSBC::get_binary_extensions(const Ref<EditorExportPreset> &p_preset) const {
+	List<String> list;
+	list.push_back(p_preset->get("binary_format/architecture"));
+	list.push_back("");
+	return list;
+}
+
+bool EditorExportPlatformSBC::is_executable(const String &p_path) const {
+	return is_elf(p_path);
+}
+
+String EditorExportPlatformSBC::get_template_file_name(const String &p_target, const String &p_arch) const {
+	return "sbc_" + p_target + "." + p_arch;
+}
+
+Error EditorExportPlatformSBC::fixup_embedded_pck(const String &p_path, int64_t p_embedded_start, int64_t p_embedded_size) {
+	// Patch the header of the "pck" section in the ELF file so that it corresponds to the embedded data.
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ_WRITE);
+	if (f.is_null()) {
+		add_message(EXPORT_MESSAGE_ERROR, TTR("PCK Embedding"), vformat(TTR("Failed to open executable file \"%s\"."), p_path));
+		return ERR_CANT_OPEN;
+	}
+
+	// Read and check ELF magic number.
+	{
+		uint32_t magic = f->get_32();
+		if (magic != 0x464c457f) { // 0x7F + "ELF"
+			add_message(EXPORT_MESSAGE_ERROR, TTR("PCK Embedding"), TTR("Executable file header corrupted."));
+			return ERR_FILE_CORRUPT;
+		}
+	}
+
+	// Read program architecture bits from class field.
+	int bits = f->get_8() * 32;
+	if (bits == 32 && p_embedded_size >= 0x100000000) {
+		add_message(EXPORT_MESSAGE_ERROR, TTR("PCK Embedding"), TTR("32-bit executables cannot have embedded data >= 4 GiB."));
+		return ERR_INVALID_DATA;
+	}
+
+	// Get info about the section header table.
+	int64_t section_table_pos;
+	int64_t section_header_size;
+	if (bits == 32) {
+		section_header_size = 40;
+		f->seek(0x20);
+		section_table_pos = f->get_32();
+		f->seek(0x30);
+	} else { // 64
+		section_header_size = 64;
+		f->seek(0x28);
+		section_table_pos = f->get_64();
+		f->seek(0x3c);
+	}
+	int num_sections = f->get_16();
+	int string_section_idx = f->get_16();
+
+	// Load the strings table.
+	Vector<uint8_t> strings;
+	{
+		f->seek(section_table_pos + string_section_idx * section_header_size);
+
+		int64_t string_data_pos;
+		int64_t string_data_size;
+		if (bits == 32) {
+			f->seek(f->get_position() + 0x10);
+			string_data_pos = f->get_32();
+			string_data_size = f->get_32();
+		} else { // 64
+			f->seek(f->get_position() + 0x18);
+			string_data_pos = f->get_64();
+			string_data_size = f->get_64();
+		}
+
+		f->seek(string_data_pos);
+		strings.resize(string_data_size + 1);
+		f->get_buffer(strings.ptrw(), string_data_size);
+		strings.write[string_data_size] = 0; // Never read past a truncated table.
+	}
+
+	// Search for the "pck" section.
+	for (int i = 0; i < num_sections; ++i) {
+		int64_t section_header_pos = section_table_pos + i * section_header_size;
+		f->seek(section_header_pos);
+
+		uint32_t name_offset = f->get_32();
+		if (name_offset < uint32_t(strings.size()) && strcmp((const char *)strings.ptr() + name_offset, "pck") == 0) {
+			if (bits == 32) {
+				f->seek(section_header_pos + 0x10);
+				f->store_32(p_embedded_start);
+				f->store_32(p_embedded_size);
+			} else { // 64
+				f->seek(section_header_pos + 0x18);
+				f->store_64(p_embedded_start);
+				f->store_64(p_embedded_size);
+			}
+			return OK;
+		}
+	}
+
+	add_message(EXPORT_MESSAGE_ERROR, TTR("PCK Embedding"), TTR("Executable \"pck\" section not found."));
+	return ERR_FILE_CORRUPT;
+}
+
+Ref<Texture2D> EditorExportPlatformSBC::get_run_icon() const {
+	return run_icon;
+}
+
+EditorExportPlatformSBC::EditorExportPlatformSBC() {
+	if (EditorNode::get_singleton()) {
+#ifdef MODULE_SVG_ENABLED
+		Ref<Image> img = memnew(Image);
+		const bool upsample = !Math::is_equal_approx(Math::round(EDSCALE), EDSCALE);
+
+		ImageLoaderSVG::create_image_from_string(img, _sbc_logo_svg, EDSCALE, upsample, false);
+		set_logo(ImageTexture::create_from_image(img));
+
+		ImageLoaderSVG::create_image_from_string(img, _sbc_run_icon_svg, EDSCALE, upsample, false);
+		run_icon = ImageTexture::create_from_image(img);
+#endif
+	}
+}
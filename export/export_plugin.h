@@ -0,0 +1,27 @@
+#ifndef SBC_EXPORT_PLUGIN_H
+#define SBC_EXPORT_PLUGIN_H
+
+#include "editor/export/editor_export_platform_pc.h"
+#include "scene/resources/image_texture.h"
+
+// Exports for ARM single-board computers. Works like the Linux exporter but
+// defaults to the ETC2/ASTC texture variants these GPUs sample natively and
+// leaves the desktop S3TC/BPTC ones out of the pack; the PCK can be embedded
+// into the "pck" ELF section reserved by godot_sbc.cpp.
+class EditorExportPlatformSBC : public EditorExportPlatformPC {
+	GDCLASS(EditorExportPlatformSBC, EditorExportPlatformPC);
+
+	Ref<ImageTexture> run_icon;
+
+public:
+	virtual void get_export_options(List<ExportOption> *r_options) const override;
+	virtual List<String> get_binary_extensions(const Ref<EditorExportPreset> &p_preset) const override;
+	virtual bool is_executable(const String &p_path) const override;
+	virtual String get_template_file_name(const String &p_target, const String &p_arch) const override;
+	virtual Error fixup_embedded_pck(const String &p_path, int64_t p_embedded_start, int64_t p_embedded_size) override;
+	virtual Ref<Texture2D> get_run_icon() const override;
+
+	EditorExportPlatformSBC();
+};
+
+#endif // SBC_EXPORT_PLUGIN_H
@@ -0,0 +1,285 @@
+#ifdef GLES3_ENABLED
+
+#include "frame_capture_sdl.h"
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+Error FrameCaptureSDL::start(const String &p_path, int p_width, int p_height, int p_ring_size) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V_MSG(active || stop_requested, ERR_BUSY, "Frame capture is already running.");
+	ERR_FAIL_COND_V(p_width <= 0 || p_height <= 0, ERR_INVALID_PARAMETER);
+
+	width = p_width;
+	height = p_height;
+	ring_size = CLAMP(p_ring_size, 2, MAX_RING_SIZE);
+	frame_bytes = uint32_t(width) * uint32_t(height) * 4;
+	shared_memory = p_path.is_empty();
+
+	shm_slots = MAX_RING_SIZE;
+	uint32_t slot_size = sizeof(SlotHeader) + frame_bytes;
+	shm_size = sizeof(Header) + size_t(slot_size) * shm_slots;
+
+	if (shared_memory) {
+		fd = memfd_create("godot_sbc_capture", MFD_CLOEXEC);
+		ERR_FAIL_COND_V_MSG(fd < 0, ERR_CANT_CREATE, "Frame capture: memfd_create failed.");
+		if (ftruncate(fd, shm_size) != 0) {
+			_close_output();
+			ERR_FAIL_V_MSG(ERR_CANT_CREATE, "Frame capture: could not size the shared memory ring.");
+		}
+		shm = (uint8_t *)mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	} else {
+		fd = open(p_path.utf8().get_data(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		ERR_FAIL_COND_V_MSG(fd < 0, ERR_FILE_CANT_OPEN, "Frame capture: could not open " + p_path);
+		shm = (uint8_t *)mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	}
+	if (shm == MAP_FAILED) {
+		shm = nullptr;
+		_close_output();
+		ERR_FAIL_V_MSG(ERR_CANT_CREATE, "Frame capture: could not map the frame ring.");
+	}
+
+	Header *header = (Header *)shm;
+	header->magic = MAGIC;
+	header->version = VERSION;
+	header->width = width;
+	header->height = height;
+	header->slot_count = shm_slots;
+	header->slot_size = slot_size;
+	header->frames_written = 0;
+	for (uint32_t i = 0; i < shm_slots; i++) {
+		((SlotHeader *)(shm + sizeof(Header) + size_t(slot_size) * i))->sequence = 0;
+	}
+
+	if (shared_memory) {
+		print_line(vformat("Frame capture: %dx%d RGBA8 into shared memory, map /proc/%d/fd/%d", width, height, OS::get_singleton()->get_process_id(), fd));
+	} else {
+		frames_flushed.set(0);
+		writer_exit.clear();
+		writer_failed.clear();
+		writer.start(&FrameCaptureSDL::_writer_func, this);
+		print_line(vformat("Frame capture: %dx%d RGBA8 raw frames into %s", width, height, p_path));
+	}
+
+	frame = 0;
+	frames_written = 0;
+	report_begin_usec = OS::get_singleton()->get_ticks_usec();
+	active = true;
+	return OK;
+}
+
+void FrameCaptureSDL::stop() {
+	MutexLock lock(mutex);
+	if (active) {
+		// GL objects belong to the render thread, which finishes up on its next frame.
+		stop_requested = true;
+	}
+}
+
+bool FrameCaptureSDL::is_active() {
+	MutexLock lock(mutex);
+	return active && !stop_requested && !writer_failed.is_set();
+}
+
+void FrameCaptureSDL::capture(int p_drawable_width, int p_drawable_height) {
+	MutexLock lock(mutex);
+	if (!active) {
+		return;
+	}
+
+	if (!stop_requested && (p_drawable_width != width || p_drawable_height != height)) {
+		WARN_PRINT("Frame capture: drawable size changed, stopping capture.");
+		stop_requested = true;
+	}
+	// The writer already reported why.
+	bool failed = writer_failed.is_set();
+	if (stop_requested || failed) {
+		// Drain what is still in flight so the output ends on the last captured frame.
+		for (int i = 0; i < ring_size && !failed; i++) {
+			int s = (slot + i) % ring_size;
+			if (fences[s]) {
+				glClientWaitSync(fences[s], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+				_write_out(s);
+			}
+		}
+		_release_gl();
+		_close_output();
+		active = false;
+		stop_requested = false;
+		print_line(vformat("Frame capture stopped after %d frames.", shared_memory ? frames_written : frames_flushed.get()));
+		return;
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	if (!gl_allocated) {
+		glGenBuffers(ring_size, pbos);
+		for (int i = 0; i < ring_size; i++) {
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[i]);
+			glBufferData(GL_PIXEL_PACK_BUFFER, frame_bytes, nullptr, GL_STREAM_READ);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		gl_allocated = true;
+	}
+
+	// The slot about to be reused holds the frame from ring_size frames ago.
+	if (fences[slot]) {
+		if (glClientWaitSync(fences[slot], 0, 0) == GL_TIMEOUT_EXPIRED) {
+			// Never block the pipeline: skip this frame instead.
+			report_dropped++;
+			frame++;
+			return;
+		}
+		_write_out(slot);
+	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[slot]);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	fence_frames[slot] = frame;
+	slot = (slot + 1) % ring_size;
+	frame++;
+
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	report_usec += now - begin;
+	report_captured++;
+	if (now - report_begin_usec >= 5000000) {
+		_report(now);
+	}
+}
+
+void FrameCaptureSDL::_write_out(int p_slot) {
+	glDeleteSync(fences[p_slot]);
+	fences[p_slot] = nullptr;
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[p_slot]);
+	const uint8_t *pixels = (const uint8_t *)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frame_bytes, GL_MAP_READ_BIT);
+	if (pixels) {
+		if (!shared_memory && frames_written - frames_flushed.get() >= shm_slots) {
+			// The writer is a full ring behind (slow storage); never wait for it here.
+			report_dropped++;
+		} else {
+			Header *header = (Header *)shm;
+			uint8_t *dst = shm + sizeof(Header) + size_t(header->slot_size) * (frames_written % shm_slots);
+			SlotHeader *slot_header = (SlotHeader *)dst;
+			// Odd while rewriting, so a reader still copying the old frame can tell.
+			uint64_t sequence = slot_header->sequence;
+			__atomic_store_n(&slot_header->sequence, sequence + 1, __ATOMIC_RELAXED);
+			__atomic_thread_fence(__ATOMIC_RELEASE);
+			slot_header->frame = fence_frames[p_slot];
+			slot_header->ticks_usec = OS::get_singleton()->get_ticks_usec();
+			memcpy(dst + sizeof(SlotHeader), pixels, frame_bytes);
+			__atomic_store_n(&slot_header->sequence, sequence + 2, __ATOMIC_RELEASE);
+			// Publish only once the slot is complete.
+			frames_written++;
+			__atomic_store_n(&header->frames_written, frames_written, __ATOMIC_RELEASE);
+			if (!shared_memory) {
+				writer_semaphore.post();
+			}
+		}
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void FrameCaptureSDL::_writer_func(void *p_userdata) {
+	FrameCaptureSDL *capture = static_cast<FrameCaptureSDL *>(p_userdata);
+	const Header *header = (const Header *)capture->shm;
+	uint64_t flushed = 0;
+
+	while (true) {
+		capture->writer_semaphore.wait();
+		bool exiting = capture->writer_exit.is_set();
+
+		uint64_t available = __atomic_load_n(&header->frames_written, __ATOMIC_ACQUIRE);
+		while (flushed < available) {
+			const uint8_t *pixels = capture->shm + sizeof(Header) + size_t(header->slot_size) * (flushed % capture->shm_slots) + sizeof(SlotHeader);
+			size_t offset = 0;
+			while (offset < capture->frame_bytes) {
+				ssize_t written = write(capture->fd, pixels + offset, capture->frame_bytes - offset);
+				if (written < 0 && errno == EINTR) {
+					continue;
+				}
+				if (written <= 0) {
+					// Stop at the first failure rather than losing every later frame too.
+					// The render thread sees the flag and tears down on its next frame.
+					ERR_PRINT(vformat("Frame capture: write failed (%s), stopping capture after %d frames.", written < 0 ? strerror(errno) : "no space written", flushed));
+					close(capture->fd);
+					capture->fd = -1;
+					capture->writer_failed.set();
+					return;
+				}
+				offset += written;
+			}
+			flushed++;
+			// Hands the slot back to the render thread.
+			capture->frames_flushed.set(flushed);
+		}
+
+		if (exiting) {
+			break;
+		}
+	}
+}
+
+void FrameCaptureSDL::_release_gl() {
+	for (int i = 0; i < MAX_RING_SIZE; i++) {
+		if (fences[i]) {
+			glDeleteSync(fences[i]);
+			fences[i] = nullptr;
+		}
+	}
+	if (gl_allocated) {
+		glDeleteBuffers(ring_size, pbos);
+		gl_allocated = false;
+	}
+	slot = 0;
+}
+
+void FrameCaptureSDL::_close_output() {
+	if (writer.is_started()) {
+		// Flushes whatever is still queued before returning.
+		writer_exit.set();
+		writer_semaphore.post();
+		writer.wait_to_finish();
+	}
+	if (shm) {
+		munmap(shm, shm_size);
+		shm = nullptr;
+	}
+	if (fd >= 0) {
+		close(fd);
+		fd = -1;
+	}
+}
+
+void FrameCaptureSDL::release() {
+	MutexLock lock(mutex);
+	_release_gl();
+	_close_output();
+	active = false;
+	stop_requested = false;
+}
+
+void FrameCaptureSDL::_report(uint64_t p_now) {
+	uint64_t frames = report_captured + report_dropped;
+	if (frames > 0) {
+		print_verbose(vformat("Frame capture: %d captured, %d dropped, render thread overhead avg %d usec per frame.",
+				report_captured, report_dropped, report_captured ? report_usec / report_captured : 0));
+	}
+	report_begin_usec = p_now;
+	report_captured = 0;
+	report_dropped = 0;
+	report_usec = 0;
+}
+
+#endif // GLES3_ENABLED
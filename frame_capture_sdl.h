@@ -0,0 +1,115 @@
+#ifndef FRAME_CAPTURE_SDL_H
+#define FRAME_CAPTURE_SDL_H
+
+#ifdef GLES3_ENABLED
+
+#include "platform_gl.h"
+
+#include "core/error/error_list.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+#include "core/string/ustring.h"
+
+// Captures presented frames without stalling the GPU pipeline. Each frame is
+// read from the backbuffer into one of a ring of pixel-pack buffers followed
+// by a fence; the buffer is only mapped once its fence has signalled, so the
+// pixels arrive `ring_size - 1` frames later and glReadPixels never blocks.
+// Frames go to a memfd ring an external encoder can map (see Header), or are
+// appended as raw RGBA8 to a file. Rows are bottom-up, as GL returns them.
+// The render thread only ever copies into the ring; file output is written
+// by a separate thread, and frames are dropped if it falls a ring behind.
+// The first failed write (e.g. a full disk) closes the file and stops the
+// capture instead of dropping every frame from then on.
+class FrameCaptureSDL {
+public:
+	static const int MAX_RING_SIZE = 4;
+	static const uint32_t MAGIC = 0x43425347; // "GSBC"
+
+	// Layout of the shared memory ring: this header, then `slot_count` slots of
+	// `slot_size` bytes, each a SlotHeader followed by width * height * 4 bytes.
+	// `frames_written` is bumped after a slot is complete; the newest frame is
+	// in slot (frames_written - 1) % slot_count.
+	//
+	// Nothing waits for readers, so a slow one can have its slot reused while
+	// copying. `sequence` is odd while the slot is being rewritten and grows
+	// by 2 per frame: load it (acquire) and skip the slot if odd, copy, then
+	// after an acquire fence load it again. The copy is valid only if both
+	// loads match.
+	static const uint32_t VERSION = 2;
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t width;
+		uint32_t height;
+		uint32_t slot_count;
+		uint32_t slot_size;
+		uint64_t frames_written;
+	};
+	struct SlotHeader {
+		uint64_t sequence;
+		uint64_t frame;
+		uint64_t ticks_usec;
+	};
+
+private:
+	Mutex mutex;
+	bool active = false;
+	bool stop_requested = false;
+
+	int width = 0;
+	int height = 0;
+	int ring_size = 3;
+	uint32_t frame_bytes = 0;
+
+	// Output, opened on the calling thread by start(). The slot ring is the
+	// memfd itself in shared memory mode, private memory in file mode.
+	int fd = -1;
+	bool shared_memory = false;
+	uint8_t *shm = nullptr;
+	size_t shm_size = 0;
+	uint32_t shm_slots = 0;
+
+	// File mode: drains the ring into fd.
+	Thread writer;
+	Semaphore writer_semaphore;
+	SafeFlag writer_exit;
+	SafeFlag writer_failed;
+	SafeNumeric<uint64_t> frames_flushed;
+
+	// GL state, only touched on the thread owning the context.
+	GLuint pbos[MAX_RING_SIZE] = {};
+	GLsync fences[MAX_RING_SIZE] = {};
+	uint64_t fence_frames[MAX_RING_SIZE] = {};
+	bool gl_allocated = false;
+	int slot = 0;
+	uint64_t frame = 0;
+	uint64_t frames_written = 0;
+
+	uint64_t report_begin_usec = 0;
+	uint64_t report_captured = 0;
+	uint64_t report_dropped = 0;
+	uint64_t report_usec = 0;
+
+	static void _writer_func(void *p_userdata);
+	void _write_out(int p_slot);
+	void _release_gl();
+	void _close_output();
+	void _report(uint64_t p_now);
+
+public:
+	// Any thread. An empty path selects the shared memory ring.
+	Error start(const String &p_path, int p_width, int p_height, int p_ring_size);
+	void stop();
+	bool is_active();
+
+	// Render thread, with the backbuffer still holding the finished frame.
+	void capture(int p_drawable_width, int p_drawable_height);
+	// Render thread, before the context goes away.
+	void release();
+};
+
+#endif // GLES3_ENABLED
+
+#endif // FRAME_CAPTURE_SDL_H
@@ -0,0 +1,119 @@
+#include "frame_pacer_sbc.h"
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+
+void FramePacerSBC::configure(bool p_enabled, float p_target_fps, float p_refresh_rate, uint64_t p_spin_usec, uint64_t p_safety_usec) {
+	enabled = p_enabled;
+
+	float fps = p_target_fps > 0.0f ? p_target_fps : p_refresh_rate;
+	if (fps <= 0.0f) {
+		fps = 60.0f;
+	}
+	period_usec = uint64_t(1000000.0 / fps);
+	spin_usec = p_spin_usec;
+	safety_usec = p_safety_usec;
+
+	next_deadline_usec = 0;
+	cost_usec = 0;
+	report_begin_usec = OS::get_singleton()->get_ticks_usec();
+
+	if (enabled) {
+		print_line("Frame pacing enabled: ", fps, " fps (", period_usec, " usec period)");
+	}
+}
+
+void FramePacerSBC::wait_for_next_frame() {
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	waited = true;
+	if (next_deadline_usec == 0) {
+		wake_target_usec = now;
+		return;
+	}
+
+	uint64_t lead = cost_usec + safety_usec;
+	wake_target_usec = next_deadline_usec > lead ? next_deadline_usec - lead : now;
+	if (wake_target_usec <= now) {
+		wake_target_usec = now; // Running late, latch input immediately.
+		return;
+	}
+
+	// Coarse sleep, then spin for the part the scheduler can't hit reliably.
+	if (wake_target_usec - now > spin_usec) {
+		OS::get_singleton()->delay_usec(wake_target_usec - now - spin_usec);
+	}
+	while (OS::get_singleton()->get_ticks_usec() < wake_target_usec) {
+		// Spin.
+	}
+}
+
+void FramePacerSBC::frame_begin() {
+	frame_begin_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Only frames that actually went through wait_for_next_frame() have a wake
+	// target to measure against; low-processor frames sleep elsewhere.
+	bool measured = waited;
+	waited = false;
+	if (!enabled || !measured) {
+		return;
+	}
+
+	if (next_deadline_usec != 0) {
+		uint64_t error = frame_begin_usec > wake_target_usec ? frame_begin_usec - wake_target_usec : wake_target_usec - frame_begin_usec;
+		report_error_sum_usec += error;
+		report_error_max_usec = MAX(report_error_max_usec, error);
+		report_frames++;
+	}
+}
+
+void FramePacerSBC::frame_end() {
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	uint64_t present_begin = present_begin_usec.get();
+	uint64_t present_end = present_end_usec.get();
+	bool presented = present_begin >= frame_begin_usec && present_end >= present_begin;
+
+	// Time blocked in the swap is vsync wait, not work. Dynamic resolution
+	// reads this even when pacing is off, the rest is pacing only.
+	last_cost_usec = presented ? present_begin - frame_begin_usec : now - frame_begin_usec;
+	if (!enabled) {
+		return;
+	}
+
+	uint64_t cost = last_cost_usec;
+	if (presented) {
+		if (next_deadline_usec != 0 && present_end > next_deadline_usec + period_usec / 2) {
+			report_missed++;
+		}
+		// A blocking swap returns right after vblank, which re-anchors the phase.
+		next_deadline_usec = present_end + period_usec;
+	} else {
+		next_deadline_usec = MAX(next_deadline_usec + period_usec, now);
+	}
+
+	if (cost > cost_usec) {
+		cost_usec = cost;
+	} else {
+		cost_usec = (cost_usec * 15 + cost) / 16;
+	}
+
+	if (now - report_begin_usec >= REPORT_INTERVAL_USEC) {
+		_report(now);
+	}
+}
+
+void FramePacerSBC::notify_present(uint64_t p_begin_usec, uint64_t p_end_usec) {
+	present_begin_usec.set(p_begin_usec);
+	present_end_usec.set(p_end_usec);
+}
+
+void FramePacerSBC::_report(uint64_t p_now) {
+	if (report_frames > 0) {
+		print_verbose(vformat("Frame pacing: %d frames, wake error avg %d usec, max %d usec, %d missed deadlines, frame cost %d usec.",
+				report_frames, report_error_sum_usec / report_frames, report_error_max_usec, report_missed, cost_usec));
+	}
+	report_begin_usec = p_now;
+	report_frames = 0;
+	report_error_sum_usec = 0;
+	report_error_max_usec = 0;
+	report_missed = 0;
+}
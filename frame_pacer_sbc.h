@@ -0,0 +1,53 @@
+#ifndef FRAME_PACER_SBC_H
+#define FRAME_PACER_SBC_H
+
+#include "core/templates/safe_refcount.h"
+#include "core/typedefs.h"
+
+// Paces OS_SBC::run so input is latched as late as possible before each frame.
+// The next vblank is predicted from the present timestamps reported by
+// swap_buffers() and the display refresh rate; the loop then sleeps until
+// (deadline - expected frame cost - safety margin), with the last stretch
+// spent spinning since OS sleeps on SBC kernels overshoot by a millisecond or
+// more.
+class FramePacerSBC {
+	bool enabled = false;
+	uint64_t period_usec = 16667;
+	uint64_t spin_usec = 1000;
+	uint64_t safety_usec = 1500;
+
+	uint64_t next_deadline_usec = 0;
+	uint64_t frame_begin_usec = 0;
+	uint64_t wake_target_usec = 0;
+	bool waited = false; // wake_target_usec belongs to the current frame.
+	uint64_t cost_usec = 0; // Fast attack, slow decay estimate of CPU work per frame.
+	uint64_t last_cost_usec = 0;
+
+	// Written from whichever thread presents.
+	SafeNumeric<uint64_t> present_begin_usec;
+	SafeNumeric<uint64_t> present_end_usec;
+
+	// Pacing error report.
+	uint64_t report_begin_usec = 0;
+	uint64_t report_frames = 0;
+	uint64_t report_error_sum_usec = 0;
+	uint64_t report_error_max_usec = 0;
+	uint64_t report_missed = 0;
+
+	void _report(uint64_t p_now);
+
+public:
+	static const uint64_t REPORT_INTERVAL_USEC = 5000000;
+
+	void configure(bool p_enabled, float p_target_fps, float p_refresh_rate, uint64_t p_spin_usec, uint64_t p_safety_usec);
+	bool is_enabled() const { return enabled; }
+
+	void wait_for_next_frame();
+	void frame_begin();
+	void frame_end();
+
+	void notify_present(uint64_t p_begin_usec, uint64_t p_end_usec);
+	uint64_t get_last_frame_cost_usec() const { return last_cost_usec; }
+};
+
+#endif // FRAME_PACER_SBC_H
@@ -0,0 +1,202 @@
+#ifdef GLES3_ENABLED
+
+#include "gl_presenter_sdl.h"
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+
+#include <dlfcn.h>
+#include <string.h>
+
+// Upper bound for a fence wait, so a lost GPU can't hang the render thread forever.
+static const GLuint64 FENCE_TIMEOUT_NSEC = 1000000000;
+
+// EGL entry points for damage-aware swaps, looked up from the libEGL SDL already loaded.
+typedef EGLDisplay (*PFN_SBC_eglGetCurrentDisplay)();
+typedef EGLSurface (*PFN_SBC_eglGetCurrentSurface)(EGLint);
+typedef const char *(*PFN_SBC_eglQueryString)(EGLDisplay, EGLint);
+typedef void *(*PFN_SBC_eglGetProcAddress)(const char *);
+typedef EGLBoolean (*PFN_SBC_eglSwapBuffersWithDamage)(EGLDisplay, EGLSurface, const EGLint *, EGLint);
+typedef EGLBoolean (*PFN_SBC_eglSwapInterval)(EGLDisplay, EGLint);
+
+static PFN_SBC_eglGetCurrentDisplay sbc_eglGetCurrentDisplay = nullptr;
+static PFN_SBC_eglGetCurrentSurface sbc_eglGetCurrentSurface = nullptr;
+static PFN_SBC_eglSwapBuffersWithDamage sbc_eglSwapBuffersWithDamage = nullptr;
+static PFN_SBC_eglSwapInterval sbc_eglSwapInterval = nullptr;
+
+void GLPresenterSDL::set_frames_in_flight(int p_frames) {
+	int frames = CLAMP(p_frames, 1, MAX_FRAMES_IN_FLIGHT);
+	if (frames == frames_in_flight) {
+		return;
+	}
+	release();
+	frames_in_flight = frames;
+}
+
+bool GLPresenterSDL::present(SDL_Window *p_window) {
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	if (report_begin_usec == 0) {
+		report_begin_usec = now;
+	}
+
+	GLsync &fence = fences[frame_index];
+	if (fence) {
+		if (drop_busy_frames) {
+			if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED) {
+				// The GPU is still behind; drop this frame rather than queue it.
+				report_dropped++;
+				return false;
+			}
+		} else {
+			uint64_t wait_begin = OS::get_singleton()->get_ticks_usec();
+			glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NSEC);
+			report_wait_usec += OS::get_singleton()->get_ticks_usec() - wait_begin;
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	uint64_t swap_begin = OS::get_singleton()->get_ticks_usec();
+	if (!_swap_with_damage(p_window)) {
+		SDL_GL_SwapWindow(p_window);
+	}
+	report_wait_usec += OS::get_singleton()->get_ticks_usec() - swap_begin;
+
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	frame_index = (frame_index + 1) % frames_in_flight;
+	report_frames++;
+
+	now = OS::get_singleton()->get_ticks_usec();
+	if (now - report_begin_usec >= 5000000) {
+		_report(now);
+	}
+	return true;
+}
+
+void GLPresenterSDL::add_damage(const LocalVector<Rect2i> &p_rects) {
+	// Appended rather than replaced, so a skipped frame
+	// doesn't lose its damage.
+	MutexLock lock(damage_mutex);
+	for (const Rect2i &rect : p_rects) {
+		damage.push_back(rect);
+	}
+}
+
+bool GLPresenterSDL::_init_damage() {
+	damage_checked = true;
+
+	// On KMSDRM, SDL_GL_SwapWindow also locks the GBM front buffer and queues
+	// the page flip, so it can't be bypassed; there is no compositor to use
+	// damage on a bare scanout either.
+	const char *video_driver = SDL_GetCurrentVideoDriver();
+	if (video_driver && strcmp(video_driver, "kmsdrm") == 0) {
+		print_verbose("GL present: KMSDRM scans out whole buffers, using full swaps.");
+		return false;
+	}
+	// SDL throttles Wayland swaps on frame callbacks itself and keeps the EGL
+	// swap interval at 0; a damage swap has to ask EGL for the vblank wait.
+	damage_wayland = video_driver && strcmp(video_driver, "wayland") == 0;
+
+	void *egl = dlopen("libEGL.so.1", RTLD_LAZY | RTLD_NOLOAD);
+	if (!egl) {
+		print_verbose("GL present: context is not EGL, using full swaps.");
+		return false;
+	}
+	sbc_eglGetCurrentDisplay = (PFN_SBC_eglGetCurrentDisplay)dlsym(egl, "eglGetCurrentDisplay");
+	sbc_eglGetCurrentSurface = (PFN_SBC_eglGetCurrentSurface)dlsym(egl, "eglGetCurrentSurface");
+	sbc_eglSwapInterval = (PFN_SBC_eglSwapInterval)dlsym(egl, "eglSwapInterval");
+	PFN_SBC_eglQueryString query_string = (PFN_SBC_eglQueryString)dlsym(egl, "eglQueryString");
+	PFN_SBC_eglGetProcAddress get_proc_address = (PFN_SBC_eglGetProcAddress)dlsym(egl, "eglGetProcAddress");
+	if (!sbc_eglGetCurrentDisplay || !sbc_eglGetCurrentSurface || !sbc_eglSwapInterval || !query_string || !get_proc_address) {
+		return false;
+	}
+
+	EGLDisplay display = sbc_eglGetCurrentDisplay();
+	if (display == EGL_NO_DISPLAY) {
+		print_verbose("GL present: context is not on EGL (GLX?), using full swaps.");
+		return false;
+	}
+	String extensions = query_string(display, EGL_EXTENSIONS);
+	if (extensions.contains("EGL_KHR_swap_buffers_with_damage")) {
+		sbc_eglSwapBuffersWithDamage = (PFN_SBC_eglSwapBuffersWithDamage)get_proc_address("eglSwapBuffersWithDamageKHR");
+	} else if (extensions.contains("EGL_EXT_swap_buffers_with_damage")) {
+		sbc_eglSwapBuffersWithDamage = (PFN_SBC_eglSwapBuffersWithDamage)get_proc_address("eglSwapBuffersWithDamageEXT");
+	}
+	print_line("GL present: swap with damage ", sbc_eglSwapBuffersWithDamage ? "available" : "not available");
+	return sbc_eglSwapBuffersWithDamage != nullptr;
+}
+
+bool GLPresenterSDL::_swap_with_damage(SDL_Window *p_window) {
+	int width = 0, height = 0;
+	SDL_GL_GetDrawableSize(p_window, &width, &height);
+	uint64_t full = uint64_t(width) * uint64_t(height);
+
+	damage_egl.clear();
+	{
+		MutexLock lock(damage_mutex);
+		for (const Rect2i &rect : damage) {
+			damage_egl.push_back(rect.position.x);
+			damage_egl.push_back(rect.position.y);
+			damage_egl.push_back(rect.size.x);
+			damage_egl.push_back(rect.size.y);
+		}
+		damage.clear();
+	}
+
+	if (!damage_enabled || damage_egl.is_empty()) {
+		report_pixels += full;
+		return false;
+	}
+	if (!damage_checked) {
+		damage_supported = _init_damage();
+	}
+	if (!damage_supported) {
+		report_pixels += full;
+		return false;
+	}
+
+	uint64_t pixels = 0;
+	for (uint32_t i = 0; i < damage_egl.size(); i += 4) {
+		pixels += uint64_t(damage_egl[i + 2]) * uint64_t(damage_egl[i + 3]);
+	}
+	report_pixels += MIN(pixels, full);
+	report_partial++;
+
+	EGLDisplay display = sbc_eglGetCurrentDisplay();
+	bool throttle = damage_wayland && SDL_GL_GetSwapInterval() != 0;
+	if (throttle) {
+		sbc_eglSwapInterval(display, 1);
+	}
+	bool swapped = sbc_eglSwapBuffersWithDamage(display, sbc_eglGetCurrentSurface(EGL_DRAW), damage_egl.ptr(), damage_egl.size() / 4) == EGL_TRUE;
+	if (throttle) {
+		sbc_eglSwapInterval(display, 0); // Back to what SDL expects for its own swaps.
+	}
+	return swapped;
+}
+
+void GLPresenterSDL::release() {
+	for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+		if (fences[i]) {
+			glDeleteSync(fences[i]);
+			fences[i] = nullptr;
+		}
+	}
+	frame_index = 0;
+}
+
+void GLPresenterSDL::_report(uint64_t p_now) {
+	uint64_t frames = report_frames + report_dropped;
+	if (frames > 0) {
+		double seconds = (p_now - report_begin_usec) / 1000000.0;
+		print_verbose(vformat("GL present (%s, %d frames in flight): %d presented (%d partial), %d dropped, CPU wait in swap avg %d usec, %.1f Mpixels/s presented.",
+				drop_busy_frames ? "dropping busy frames" : "waiting", frames_in_flight, report_frames, report_partial, report_dropped, report_wait_usec / frames, report_pixels / seconds / 1000000.0));
+	}
+	report_begin_usec = p_now;
+	report_frames = 0;
+	report_dropped = 0;
+	report_wait_usec = 0;
+	report_pixels = 0;
+	report_partial = 0;
+}
+
+#endif // GLES3_ENABLED
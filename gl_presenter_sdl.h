@@ -0,0 +1,73 @@
+#ifndef GL_PRESENTER_SDL_H
+#define GL_PRESENTER_SDL_H
+
+#ifdef GLES3_ENABLED
+
+#include "platform_gl.h"
+
+#include "core/math/rect2i.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/typedefs.h"
+#include <SDL2/SDL.h>
+
+// Presents the GLES backbuffer while bounding how far the CPU may run ahead of
+// the GPU. A fence is inserted after every swap; before the next swap into the
+// same slot the CPU waits on it, so at most `frames_in_flight` frames are ever
+// queued. With drop_busy_frames (only used with VSync disabled) a frame whose
+// slot is still busy is skipped instead of waited on, so the CPU never blocks.
+// That is frame skipping, not mailbox: the skipped frame was already rendered
+// and swaps still tear, EGL has no way to replace a queued frame at vblank.
+//
+// When damage rects are set for a frame and the EGL driver exposes
+// EGL_KHR_swap_buffers_with_damage (or the EXT variant), the swap tells the
+// compositor which regions changed so it can skip recomposing the rest.
+// Availability is decided by the extension on the current EGL display (X11
+// is switched to EGL when damage is enabled). The swap bypasses
+// SDL_GL_SwapWindow, so KMSDRM, where SDL also queues the page flip, keeps
+// full swaps, and on Wayland the vblank wait SDL would do is asked of EGL.
+class GLPresenterSDL {
+public:
+	static const int MAX_FRAMES_IN_FLIGHT = 3;
+
+private:
+	GLsync fences[MAX_FRAMES_IN_FLIGHT] = {};
+	int frame_index = 0;
+	int frames_in_flight = 2;
+	bool drop_busy_frames = false;
+
+	// Damage for the next present, in GL window coordinates (origin bottom-left).
+	Mutex damage_mutex;
+	LocalVector<Rect2i> damage;
+	LocalVector<int32_t> damage_egl; // Render thread only.
+	bool damage_enabled = false;
+	bool damage_checked = false;
+	bool damage_supported = false;
+	bool damage_wayland = false;
+
+	uint64_t report_begin_usec = 0;
+	uint64_t report_frames = 0;
+	uint64_t report_dropped = 0;
+	uint64_t report_wait_usec = 0;
+	uint64_t report_pixels = 0;
+	uint64_t report_partial = 0;
+
+	bool _init_damage();
+	bool _swap_with_damage(SDL_Window *p_window);
+	void _report(uint64_t p_now);
+
+public:
+	void set_frames_in_flight(int p_frames);
+	void set_drop_busy_frames(bool p_drop) { drop_busy_frames = p_drop; }
+	void set_damage_enabled(bool p_enabled) { damage_enabled = p_enabled; }
+	// Any thread. Accumulates until the next swap; no damage means the whole frame.
+	void add_damage(const LocalVector<Rect2i> &p_rects);
+
+	// Must be called with the context current. Returns false if the frame was dropped.
+	bool present(SDL_Window *p_window);
+	void release();
+};
+
+#endif // GLES3_ENABLED
+
+#endif // GL_PRESENTER_SDL_H
@@ -0,0 +1,73 @@
+#include "gl_proc_loader_sdl.h"
+
+#ifdef GLES3_ENABLED
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include <SDL2/SDL.h>
+
+HashMap<const char *, GLADapiproc, GLProcLoaderSDL::NameHasher, GLProcLoaderSDL::NameComparator> GLProcLoaderSDL::procs;
+LocalVector<const char *> GLProcLoaderSDL::missing;
+bool GLProcLoaderSDL::loaded = false;
+
+static const uint32_t MAX_LOGGED_MISSING = 16;
+
+GLADapiproc GLProcLoaderSDL::_resolve(const char *p_name) {
+	GLADapiproc proc = (GLADapiproc)SDL_GL_GetProcAddress(p_name);
+	procs.insert(p_name, proc);
+	if (!proc) {
+		missing.push_back(p_name);
+	}
+	return proc;
+}
+
+__eglMustCastToProperFunctionPointerType GLAD_API_PTR GLProcLoaderSDL::_get_proc_address(const char *p_name) {
+	// Misses were already reported by load(), stay silent here.
+	HashMap<const char *, GLADapiproc, NameHasher, NameComparator>::ConstIterator E = procs.find(p_name);
+	if (E) {
+		return (__eglMustCastToProperFunctionPointerType)E->value;
+	}
+	// Not part of the GLES table (e.g. EGL extensions), ask SDL directly.
+	return (__eglMustCastToProperFunctionPointerType)SDL_GL_GetProcAddress(p_name);
+}
+
+bool GLProcLoaderSDL::load() {
+	if (loaded) {
+		return true;
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	procs.reserve(1024);
+	const int version = gladLoadGLES2((GLADloadfunc)&GLProcLoaderSDL::_resolve);
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	if (version == 0) {
+		print_line("GL loader: gladLoadGLES2 failed, is the context current?");
+		procs.clear();
+		missing.clear();
+		return false;
+	}
+
+	String summary = vformat("GL loader: OpenGL ES %d.%d, %d entry points resolved in %.2f ms",
+			GLAD_VERSION_MAJOR(version), GLAD_VERSION_MINOR(version), procs.size() - missing.size(), elapsed / 1000.0);
+	if (!missing.is_empty()) {
+		summary += vformat(", %d missing:", missing.size());
+		for (uint32_t i = 0; i < MIN(missing.size(), MAX_LOGGED_MISSING); i++) {
+			summary += String(" ") + missing[i];
+		}
+		if (missing.size() > MAX_LOGGED_MISSING) {
+			summary += vformat(" (+%d more)", missing.size() - MAX_LOGGED_MISSING);
+		}
+	}
+	print_line(summary);
+	missing.clear();
+
+	// RasterizerGLES3 resolves through eglGetProcAddress when EGL_ENABLED is
+	// set; under SDL nothing loads glad's EGL table, so hand it ours.
+	eglGetProcAddress = &GLProcLoaderSDL::_get_proc_address;
+
+	loaded = true;
+	return true;
+}
+
+#endif // GLES3_ENABLED
@@ -0,0 +1,42 @@
+#ifndef GL_PROC_LOADER_SDL_H
+#define GL_PROC_LOADER_SDL_H
+
+#ifdef GLES3_ENABLED
+
+#include "platform_gl.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+
+// Resolves the GLES entry points once, in a single pass through
+// SDL_GL_GetProcAddress, right after the context is made current. The table
+// is then served to glad through its eglGetProcAddress pointer, so the
+// stock RasterizerGLES3 loader (EGL_ENABLED path) finds everything with a
+// lookup instead of patching core to call SDL. Symbols the driver lacks are
+// reported once in a summary line rather than one printf each.
+class GLProcLoaderSDL {
+	struct NameHasher {
+		static _FORCE_INLINE_ uint32_t hash(const char *p_name) { return hash_djb2(p_name); }
+	};
+	struct NameComparator {
+		static _FORCE_INLINE_ bool compare(const char *p_lhs, const char *p_rhs) { return strcmp(p_lhs, p_rhs) == 0; }
+	};
+
+	// Keys are glad's static name strings.
+	static HashMap<const char *, GLADapiproc, NameHasher, NameComparator> procs;
+	static LocalVector<const char *> missing;
+	static bool loaded;
+
+	static GLADapiproc _resolve(const char *p_name);
+	static __eglMustCastToProperFunctionPointerType GLAD_API_PTR _get_proc_address(const char *p_name);
+
+public:
+	// Context must be current. Safe to call again; later calls are no-ops.
+	static bool load();
+	static bool is_loaded() { return loaded; }
+};
+
+#endif // GLES3_ENABLED
+
+#endif // GL_PROC_LOADER_SDL_H
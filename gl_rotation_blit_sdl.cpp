@@ -0,0 +1,211 @@
+#ifdef GLES3_ENABLED
+
+#include "gl_rotation_blit_sdl.h"
+
+#include "core/error/error_macros.h"
+#include "core/math/math_funcs.h"
+#include "core/string/print_string.h"
+#include "drivers/gles3/storage/texture_storage.h"
+
+static const char *rotation_vertex_shader = R"(#version 300 es
+uniform mat2 uv_rotation;
+out vec2 uv;
+void main() {
+	vec2 pos = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)) * 2.0 - 1.0;
+	uv = uv_rotation * (pos * 0.5) + 0.5;
+	gl_Position = vec4(pos, 0.0, 1.0);
+}
+)";
+
+static const char *rotation_fragment_shader = R"(#version 300 es
+precision mediump float;
+uniform sampler2D source;
+in vec2 uv;
+out vec4 frag_color;
+void main() {
+	frag_color = texture(source, uv);
+}
+)";
+
+static GLuint _compile_shader(GLenum p_type, const char *p_source) {
+	GLuint shader = glCreateShader(p_type);
+	glShaderSource(shader, 1, &p_source, nullptr);
+	glCompileShader(shader);
+	GLint status = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (!status) {
+		char log[512] = {};
+		glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+		ERR_PRINT("Display rotation shader failed to compile: " + String(log));
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+bool GLRotationBlitSDL::_create_program() {
+	GLuint vertex = _compile_shader(GL_VERTEX_SHADER, rotation_vertex_shader);
+	GLuint fragment = _compile_shader(GL_FRAGMENT_SHADER, rotation_fragment_shader);
+	if (!vertex || !fragment) {
+		glDeleteShader(vertex);
+		glDeleteShader(fragment);
+		return false;
+	}
+
+	program = glCreateProgram();
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	glLinkProgram(program);
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+
+	GLint status = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (!status) {
+		ERR_PRINT("Display rotation shader failed to link.");
+		glDeleteProgram(program);
+		program = 0;
+		return false;
+	}
+
+	glUseProgram(program);
+	uv_rotation_location = glGetUniformLocation(program, "uv_rotation");
+	glUniform1i(glGetUniformLocation(program, "source"), 0);
+	glUseProgram(0);
+
+	// GLES3 won't draw without a vertex array bound, even an empty one.
+	glGenVertexArrays(1, &vertex_array);
+	return true;
+}
+
+void GLRotationBlitSDL::present(const Size2i &p_physical) {
+	if (!is_enabled()) {
+		return;
+	}
+
+	Size2i logical = (rotation == 90 || rotation == 270) ? Size2i(p_physical.height, p_physical.width) : p_physical;
+
+	if (fbo == 0) {
+		if (!_create_program()) {
+			rotation = 0;
+			offscreen = false;
+			return;
+		}
+		glGenFramebuffers(1, &fbo);
+		glGenTextures(1, &color);
+		// From the next frame on the rasterizer blits into our target instead of the backbuffer.
+		GLES3::TextureStorage::get_singleton()->system_fbo = fbo;
+		print_line(vformat("Rendering offscreen at %dx%d, display rotated %d degrees.", logical.width, logical.height, rotation));
+	}
+
+	if (logical != size) {
+		size = logical;
+		glBindTexture(GL_TEXTURE_2D, color);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size.width, size.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		// Exact at 1:1, and smooths scaled mirrors.
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+		glClearColor(0, 0, 0, 1);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	_draw(Rect2i(Point2i(), p_physical), rotation);
+}
+
+void GLRotationBlitSDL::draw_mirror(const Size2i &p_target, Stretch p_stretch) {
+	if (fbo == 0 || size.width <= 0 || size.height <= 0) {
+		return;
+	}
+
+	Rect2i viewport(Point2i(), p_target);
+	if (p_stretch == STRETCH_FIT) {
+		float scale = MIN(float(p_target.width) / size.width, float(p_target.height) / size.height);
+		Size2i fitted(size.width * scale, size.height * scale);
+		viewport = Rect2i((p_target - fitted) / 2, fitted);
+
+		GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+		glDisable(GL_SCISSOR_TEST);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glClearColor(0, 0, 0, 1);
+		glClear(GL_COLOR_BUFFER_BIT);
+		if (scissor) {
+			glEnable(GL_SCISSOR_TEST);
+		}
+	}
+	_draw(viewport, 0);
+}
+
+void GLRotationBlitSDL::_draw(const Rect2i &p_viewport, int p_rotation) {
+	// Mapping a panel position to the logical image undoes the clockwise
+	// rotation, i.e. rotates counter-clockwise by the same angle.
+	float angle = Math::deg_to_rad(float(p_rotation));
+	float c = Math::round(Math::cos(angle));
+	float s = Math::round(Math::sin(angle));
+	const GLfloat matrix[4] = { c, s, -s, c }; // Column-major.
+
+	// Leave the rasterizer's state as we found it.
+	GLboolean blend = glIsEnabled(GL_BLEND);
+	GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+	GLboolean depth = glIsEnabled(GL_DEPTH_TEST);
+	GLboolean cull = glIsEnabled(GL_CULL_FACE);
+	GLboolean stencil = glIsEnabled(GL_STENCIL_TEST);
+	glDisable(GL_BLEND);
+	glDisable(GL_SCISSOR_TEST);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_STENCIL_TEST);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(p_viewport.position.x, p_viewport.position.y, p_viewport.size.width, p_viewport.size.height);
+	glUseProgram(program);
+	glUniformMatrix2fv(uv_rotation_location, 1, GL_FALSE, matrix);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, color);
+	glBindVertexArray(vertex_array);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+
+	if (blend) {
+		glEnable(GL_BLEND);
+	}
+	if (scissor) {
+		glEnable(GL_SCISSOR_TEST);
+	}
+	if (depth) {
+		glEnable(GL_DEPTH_TEST);
+	}
+	if (cull) {
+		glEnable(GL_CULL_FACE);
+	}
+	if (stencil) {
+		glEnable(GL_STENCIL_TEST);
+	}
+}
+
+void GLRotationBlitSDL::release() {
+	if (fbo) {
+		if (GLES3::TextureStorage::get_singleton()) {
+			GLES3::TextureStorage::get_singleton()->system_fbo = 0;
+		}
+		glDeleteFramebuffers(1, &fbo);
+		glDeleteTextures(1, &color);
+		fbo = 0;
+		color = 0;
+		size = Size2i();
+	}
+	if (program) {
+		glDeleteProgram(program);
+		glDeleteVertexArrays(1, &vertex_array);
+		program = 0;
+		vertex_array = 0;
+	}
+}
+
+#endif // GLES3_ENABLED
@@ -0,0 +1,54 @@
+#ifndef GL_ROTATION_BLIT_SDL_H
+#define GL_ROTATION_BLIT_SDL_H
+
+#ifdef GLES3_ENABLED
+
+#include "platform_gl.h"
+
+#include "core/math/vector2i.h"
+
+// Rotates the final image for panels mounted in portrait or upside down.
+// The rasterizer's screen blit is redirected (through TextureStorage's
+// system_fbo) into an offscreen target at the logical, rotated size, which
+// present() then draws into the real backbuffer with a single textured
+// triangle strip whose UVs carry the rotation. Rotation is in degrees
+// clockwise as seen on the panel. The same offscreen frame can be drawn,
+// scaled, into other windows sharing the context (see MirrorDisplaysSDL).
+class GLRotationBlitSDL {
+public:
+	enum Stretch {
+		STRETCH_FIT, // Keep aspect, letterbox.
+		STRETCH_FILL, // Stretch to the whole target.
+	};
+
+private:
+	int rotation = 0;
+	bool offscreen = false;
+
+	GLuint fbo = 0;
+	GLuint color = 0;
+	Size2i size;
+
+	GLuint program = 0;
+	GLint uv_rotation_location = -1;
+	GLuint vertex_array = 0;
+
+	bool _create_program();
+	void _draw(const Rect2i &p_viewport, int p_rotation);
+
+public:
+	void set_rotation(int p_degrees) { rotation = p_degrees; }
+	// Render offscreen even without rotation, so the frame can be mirrored.
+	void set_offscreen(bool p_offscreen) { offscreen = p_offscreen; }
+	bool is_enabled() const { return rotation != 0 || offscreen; }
+
+	// With the context current, right before swapping. p_physical is the drawable size.
+	void present(const Size2i &p_physical);
+	// With the context current on another window, after present().
+	void draw_mirror(const Size2i &p_target, Stretch p_stretch);
+	void release();
+};
+
+#endif // GLES3_ENABLED
+
+#endif // GL_ROTATION_BLIT_SDL_H
@@ -0,0 +1,71 @@
+#ifdef GLES3_ENABLED
+
+#include "mirror_displays_sdl.h"
+
+#include "core/string/print_string.h"
+
+void MirrorDisplaysSDL::open(const PackedInt32Array &p_screens, int p_main_screen, GLRotationBlitSDL::Stretch p_stretch) {
+	stretch = p_stretch;
+	int num_displays = SDL_GetNumVideoDisplays();
+
+	for (int i = 0; i < p_screens.size(); i++) {
+		int screen = p_screens[i];
+		if (screen == p_main_screen || screen < 0 || screen >= num_displays) {
+			WARN_PRINT(vformat("Cannot mirror to screen %d (main screen %d, %d displays).", screen, p_main_screen, num_displays));
+			continue;
+		}
+
+		Mirror mirror;
+		mirror.screen = screen;
+		mirror.window = SDL_CreateWindow("Godot mirror",
+				SDL_WINDOWPOS_CENTERED_DISPLAY(screen), SDL_WINDOWPOS_CENTERED_DISPLAY(screen), 640, 480,
+				SDL_WINDOW_OPENGL | SDL_WINDOW_FULLSCREEN_DESKTOP | SDL_WINDOW_BORDERLESS);
+		if (!mirror.window) {
+			WARN_PRINT(vformat("Could not open mirror window on screen %d: %s", screen, SDL_GetError()));
+			continue;
+		}
+		mirrors.push_back(mirror);
+		print_line("Mirroring to screen ", screen);
+	}
+}
+
+void MirrorDisplaysSDL::close() {
+	for (Mirror &mirror : mirrors) {
+		SDL_DestroyWindow(mirror.window);
+	}
+	mirrors.clear();
+}
+
+bool MirrorDisplaysSDL::owns_window(Uint32 p_window_id) const {
+	for (const Mirror &mirror : mirrors) {
+		if (SDL_GetWindowID(mirror.window) == p_window_id) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void MirrorDisplaysSDL::present(SDL_Window *p_main_window, SDL_GLContext p_context, GLRotationBlitSDL &p_blit) {
+	if (mirrors.is_empty()) {
+		return;
+	}
+
+	int main_interval = SDL_GL_GetSwapInterval();
+	for (Mirror &mirror : mirrors) {
+		if (SDL_GL_MakeCurrent(mirror.window, p_context) != 0) {
+			continue;
+		}
+		// Set per swap: on EGL/GLX the call only reaches the current surface.
+		SDL_GL_SetSwapInterval(0);
+
+		int width = 0, height = 0;
+		SDL_GL_GetDrawableSize(mirror.window, &width, &height);
+		p_blit.draw_mirror(Size2i(width, height), stretch);
+		SDL_GL_SwapWindow(mirror.window);
+	}
+
+	SDL_GL_MakeCurrent(p_main_window, p_context);
+	SDL_GL_SetSwapInterval(main_interval);
+}
+
+#endif // GLES3_ENABLED
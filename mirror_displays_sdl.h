@@ -0,0 +1,42 @@
+#ifndef MIRROR_DISPLAYS_SDL_H
+#define MIRROR_DISPLAYS_SDL_H
+
+#ifdef GLES3_ENABLED
+
+#include "gl_rotation_blit_sdl.h"
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+#include <SDL2/SDL.h>
+
+// Shows the main window's frame on additional displays without rendering
+// the scene again. Each mirror is a borderless fullscreen SDL window on its
+// own display that uses the main GL context; after the main present, the
+// context is switched to each mirror in turn, the offscreen frame kept by
+// GLRotationBlitSDL is drawn scaled into it, and it swaps with interval 0 so
+// mirrors never add vsync waits to the main display. SDL2 keeps one swap
+// interval for the whole video device (KMSDRM and Wayland read it on every
+// swap), so the main window's interval is put back before returning.
+class MirrorDisplaysSDL {
+	struct Mirror {
+		SDL_Window *window = nullptr;
+		int screen = -1;
+	};
+
+	LocalVector<Mirror> mirrors;
+	GLRotationBlitSDL::Stretch stretch = GLRotationBlitSDL::STRETCH_FIT;
+
+public:
+	// Main thread. Screens equal to p_main_screen or out of range are skipped.
+	void open(const PackedInt32Array &p_screens, int p_main_screen, GLRotationBlitSDL::Stretch p_stretch);
+	void close();
+	bool is_empty() const { return mirrors.is_empty(); }
+	bool owns_window(Uint32 p_window_id) const;
+
+	// Render thread, after the main window presented; makes the main window current again.
+	void present(SDL_Window *p_main_window, SDL_GLContext p_context, GLRotationBlitSDL &p_blit);
+};
+
+#endif // GLES3_ENABLED
+
+#endif // MIRROR_DISPLAYS_SDL_H
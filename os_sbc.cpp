@@ -1,11 +1,14 @@
 #include "os_sbc.h"
 #include "display_server_sdl.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "main/main.h"
 #include "servers/display_server.h"
 #include "servers/rendering_server.h"
 
+#include <sys/resource.h>
+
 #ifdef GLES3_ENABLED
 
 #include <GLES3/gl3.h>
@@ -36,17 +39,81 @@ void OS_SBC::run() {
 	main_loop->initialize();
 	print_line("Main loop initialized successfully");
 
+	// Leave Engine max_fps at 0 when pacing, otherwise both limiters sleep.
+	frame_pacer.configure(
+			GLOBAL_DEF("application/run/sbc/frame_pacing", false),
+			GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "application/run/sbc/target_frame_rate", PROPERTY_HINT_RANGE, "0,240,1,suffix:fps"), 0),
+			DisplayServer::get_singleton()->screen_get_refresh_rate(),
+			GLOBAL_DEF(PropertyInfo(Variant::INT, "application/run/sbc/frame_pacing_spin_usec", PROPERTY_HINT_RANGE, "0,5000,1,suffix:usec"), 1000),
+			GLOBAL_DEF(PropertyInfo(Variant::INT, "application/run/sbc/frame_pacing_safety_margin_usec", PROPERTY_HINT_RANGE, "0,10000,1,suffix:usec"), 1500));
+
+	cpu_report_begin_usec = 0;
+
 	while (!quit_requested) {
+		bool idle = is_in_low_processor_usage_mode() || !DisplayServer::get_singleton()->can_any_window_draw();
+		if (idle) {
+			_report_cpu_usage(get_ticks_usec());
+		} else if (frame_pacer.is_enabled()) {
+			frame_pacer.wait_for_next_frame();
+		}
+		frame_pacer.frame_begin();
+
+		// Input is pumped right before simulation, after the pacer's sleep.
 		DisplayServerSDL::get_singleton()->process_events();
 
-		if (Main::iteration()) {
+		// Main::iteration ends idle frames with delay_usec(low-processor sleep),
+		// which delay_usec() turns into an event wait.
+		idle_sleep_pending = idle;
+		bool quit = Main::iteration();
+		idle_sleep_pending = false;
+		if (quit) {
 			break;
 		}
+
+		frame_pacer.frame_end();
 	}
 
 	main_loop->finalize();
 }
 
+void OS_SBC::delay_usec(uint32_t p_usec) const {
+	// The engine's idle sleep at the end of a low-processor (or hidden window)
+	// iteration. Blocking in SDL instead lets input cut it short, while the
+	// duration stays whatever the project or a script configured.
+	if (idle_sleep_pending && p_usec >= 1000 && Thread::get_caller_id() == Thread::get_main_id()) {
+		idle_sleep_pending = false;
+		SDL_WaitEventTimeout(nullptr, int((p_usec + 999) / 1000));
+		return;
+	}
+	OS_Unix::delay_usec(p_usec);
+}
+
+void OS_SBC::_report_cpu_usage(uint64_t p_now) {
+	if (!is_stdout_verbose()) {
+		return;
+	}
+
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return;
+	}
+	uint64_t cpu_usec = uint64_t(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+
+	if (cpu_report_begin_usec == 0) {
+		cpu_report_begin_usec = p_now;
+		cpu_report_begin_cpu_usec = cpu_usec;
+		return;
+	}
+	if (p_now - cpu_report_begin_usec < FramePacerSBC::REPORT_INTERVAL_USEC) {
+		return;
+	}
+
+	double percent = 100.0 * double(cpu_usec - cpu_report_begin_cpu_usec) / double(p_now - cpu_report_begin_usec);
+	print_verbose(vformat("Low-processor mode: %.1f%% CPU (one core) over the last %.1f s.", percent, (p_now - cpu_report_begin_usec) / 1000000.0));
+	cpu_report_begin_usec = p_now;
+	cpu_report_begin_cpu_usec = cpu_usec;
+}
+
 MainLoop *OS_SBC::get_main_loop() const {
 	return main_loop;
 }
@@ -74,7 +141,93 @@ void OS_SBC::initialize_joypads() {
 }
 
 bool OS_SBC::_check_internal_feature_support(const String &p_feature) {
-	return p_feature == "pc" || p_feature == "s3tc";
+	if (p_feature == "pc") {
+		return true;
+	}
+	if (!texture_formats_probed) {
+		// No rendering context (headless, or asked too early), keep the old answer.
+		return p_feature == "s3tc";
+	}
+	if (p_feature == "etc2") {
+		return texture_formats & TEXTURE_FORMAT_ETC2;
+	}
+	if (p_feature == "astc") {
+		return texture_formats & TEXTURE_FORMAT_ASTC;
+	}
+	if (p_feature == "s3tc") {
+		return texture_formats & TEXTURE_FORMAT_S3TC;
+	}
+	if (p_feature == "bptc") {
+		return texture_formats & TEXTURE_FORMAT_BPTC;
+	}
+	return false;
+}
+
+void OS_SBC::set_texture_formats(uint32_t p_formats) {
+	texture_formats = p_formats;
+	texture_formats_probed = true;
+	print_line(vformat("Native compressed texture formats:%s%s%s%s",
+			(p_formats & TEXTURE_FORMAT_ETC2) ? " etc2" : "",
+			(p_formats & TEXTURE_FORMAT_ASTC) ? " astc" : "",
+			(p_formats & TEXTURE_FORMAT_S3TC) ? " s3tc" : "",
+			(p_formats & TEXTURE_FORMAT_BPTC) ? " bptc" : ""));
+}
+
+void OS_SBC::apply_device_profile(const String &p_renderer) {
+	const Array tiers = GLOBAL_DEF(PropertyInfo(Variant::ARRAY, "application/run/sbc/quality_tiers", PROPERTY_HINT_TYPE_STRING, itos(Variant::DICTIONARY) + ":"), DeviceProfileSBC::get_default_tiers());
+	const String forced_tier = GLOBAL_DEF("application/run/sbc/quality_tier", "");
+	if (!GLOBAL_DEF("application/run/sbc/auto_quality_tier", false) && forced_tier.is_empty()) {
+		return;
+	}
+
+	device_profile.probe(p_renderer);
+
+	Dictionary tier;
+	bool cached = false;
+	if (forced_tier.is_empty()) {
+		tier = device_profile.select_tier_cached(tiers, cached);
+	} else {
+		for (int i = 0; i < tiers.size(); i++) {
+			if (tiers[i].get_type() == Variant::DICTIONARY && String(Dictionary(tiers[i]).get("name", String())) == forced_tier) {
+				tier = tiers[i];
+				break;
+			}
+		}
+	}
+	if (tier.is_empty()) {
+		print_line("Device profile: " + device_profile.to_string() + ", no quality tier matched.");
+		return;
+	}
+	print_line(vformat("Device profile: %s, quality tier \"%s\"%s.", device_profile.to_string(), tier.get("name", ""), !forced_tier.is_empty() ? " (forced)" : (cached ? " (cached)" : "")));
+
+	// Nothing has read these yet: the rendering server, the scene tree's root
+	// viewport and the audio server all initialize after the display server.
+	ProjectSettings *settings = ProjectSettings::get_singleton();
+	if (tier.has("render_scale")) {
+		settings->set_setting("rendering/scaling_3d/scale", CLAMP(float(tier["render_scale"]), 0.25f, 2.0f));
+	}
+	if (tier.has("msaa")) {
+		settings->set_setting("rendering/anti_aliasing/quality/msaa_3d", CLAMP(int(tier["msaa"]), 0, 3));
+	}
+	if (tier.has("shadow_quality")) {
+		// 0: 1024 hard, 1: 2048 "Soft Very Low", 2: 4096 "Soft Low".
+		int quality = CLAMP(int(tier["shadow_quality"]), 0, 2);
+		settings->set_setting("rendering/lights_and_shadows/directional_shadow/size", 1024 << quality);
+		settings->set_setting("rendering/lights_and_shadows/directional_shadow/soft_shadow_filter_quality", quality);
+		settings->set_setting("rendering/lights_and_shadows/positional_shadow/atlas_size", 1024 << quality);
+		settings->set_setting("rendering/lights_and_shadows/positional_shadow/soft_shadow_filter_quality", quality);
+	}
+	// Only from a project's own tiers, and never over a tick rate the project set itself.
+	if (tier.has("physics_ticks") && !settings->property_can_revert("physics/common/physics_ticks_per_second")) {
+		int ticks = CLAMP(int(tier["physics_ticks"]), 1, 1000);
+		settings->set_setting("physics/common/physics_ticks_per_second", ticks);
+		Engine::get_singleton()->set_physics_ticks_per_second(ticks);
+	}
+	if (tier.has("audio_latency_ms")) {
+		int latency_ms = CLAMP(int(tier["audio_latency_ms"]), 1, 500);
+		settings->set_setting("audio/driver/output_latency", latency_ms);
+		audio_driver_sbc.set_output_latency_ms(latency_ms);
+	}
 }
 
 OS_SBC::OS_SBC() {
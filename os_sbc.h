@@ -3,7 +3,9 @@
 
 #include "audio_driver_sbc.h"
 #include "core/os/os.h"
+#include "device_profile_sbc.h"
 #include "drivers/unix/os_unix.h"
+#include "frame_pacer_sbc.h"
 #include <SDL2/SDL.h>
 
 class OS_SBC : public OS_Unix {
@@ -11,6 +13,22 @@ class OS_SBC : public OS_Unix {
 	virtual void delete_main_loop() override;
 	AudioDriverSBC audio_driver_sbc;
 	bool quit_requested = false;
+	FramePacerSBC frame_pacer;
+
+	// Low-processor mode: the engine's own idle sleep is served by
+	// SDL_WaitEventTimeout so the loop wakes as soon as input arrives.
+	mutable bool idle_sleep_pending = false;
+	uint64_t cpu_report_begin_usec = 0;
+	uint64_t cpu_report_begin_cpu_usec = 0;
+
+	// Compressed texture formats the GPU samples natively, probed by the display
+	// server once the rendering context exists.
+	uint32_t texture_formats = 0;
+	bool texture_formats_probed = false;
+
+	DeviceProfileSBC device_profile;
+
+	void _report_cpu_usage(uint64_t p_now);
 
 protected:
 	virtual void initialize() override;
@@ -19,6 +37,13 @@ protected:
 	virtual void finalize() override;
 
 public:
+	enum TextureFormat {
+		TEXTURE_FORMAT_ETC2 = 1 << 0,
+		TEXTURE_FORMAT_ASTC = 1 << 1,
+		TEXTURE_FORMAT_S3TC = 1 << 2,
+		TEXTURE_FORMAT_BPTC = 1 << 3,
+	};
+
 	static OS_SBC *get_singleton();
 	static OS *create();
 
@@ -26,6 +51,7 @@ public:
 	virtual String get_name() const override;
 
 	virtual MainLoop *get_main_loop() const override;
+	virtual void delay_usec(uint32_t p_usec) const override;
 
 	virtual bool _check_internal_feature_support(const String &p_feature) override;
 	void run();
@@ -34,6 +60,13 @@ public:
 	virtual String get_data_path() const override;
 	virtual String get_cache_path() const override;
 	void set_quit_requested(bool p_quit);
+	FramePacerSBC &get_frame_pacer() { return frame_pacer; }
+	void set_texture_formats(uint32_t p_formats);
+
+	// Called by the display server once the renderer is known, before the
+	// rendering and audio servers read their settings.
+	void apply_device_profile(const String &p_renderer);
+	const DeviceProfileSBC &get_device_profile() const { return device_profile; }
 
 	OS_SBC();
 	~OS_SBC();
@@ -39,9 +39,9 @@
 #define GLES_API_ENABLED // Allow using GLES.
 #endif
 
-// #ifndef EGL_ENABLED
-// #define EGL_ENABLED // Allow using EGL.
-// #endif
+#ifndef EGL_ENABLED
+#define EGL_ENABLED // Allow using EGL. SDL owns the EGL display, see gl_proc_loader_sdl.h.
+#endif
 
 #ifndef GLAD_ENABLED
 #define GLAD_ENABLED // Allow using GLAD.
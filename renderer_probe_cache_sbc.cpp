@@ -0,0 +1,119 @@
+#include "renderer_probe_cache_sbc.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/os/time.h"
+#include "core/string/print_string.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+String RendererProbeCacheSBC::_read_first_line(const char *p_path) {
+	// sysfs reports a bogus file size, so read it like a stream.
+	FILE *file = fopen(p_path, "r");
+	if (!file) {
+		return String();
+	}
+	char line[256] = {};
+	if (!fgets(line, sizeof(line), file)) {
+		line[0] = '\0';
+	}
+	fclose(file);
+	return String::utf8(line).strip_edges();
+}
+
+String RendererProbeCacheSBC::_gpu_id() {
+	char driver[256] = {};
+	ssize_t len = readlink("/sys/class/drm/card0/device/driver", driver, sizeof(driver) - 1);
+	String driver_name = len > 0 ? String::utf8(driver, len).get_file() : String("unknown");
+	return driver_name + ":" + _read_first_line("/sys/class/drm/card0/device/modalias");
+}
+
+String RendererProbeCacheSBC::_icd_id() {
+	// Mesa updates replace the manifests and the libraries they name, so
+	// their mtimes change even when the kernel and GPU don't.
+	static const char *icd_dirs[] = { "/usr/share/vulkan/icd.d", "/usr/local/share/vulkan/icd.d", "/etc/vulkan/icd.d" };
+	static const char *icd_overrides[] = { "VK_ICD_FILENAMES", "VK_DRIVER_FILES" };
+	String fingerprint;
+	for (const char *dir : icd_dirs) {
+		if (!DirAccess::dir_exists_absolute(dir)) {
+			continue;
+		}
+		PackedStringArray files = DirAccess::get_files_at(dir);
+		files.sort();
+		for (const String &file : files) {
+			String manifest = String(dir).path_join(file);
+			struct stat st;
+			if (!file.ends_with(".json") || stat(manifest.utf8().get_data(), &st) != 0) {
+				continue;
+			}
+			fingerprint += manifest + ":" + itos(st.st_mtime) + ";";
+
+			Variant parsed = JSON::parse_string(FileAccess::get_file_as_string(manifest));
+			if (parsed.get_type() != Variant::DICTIONARY) {
+				continue;
+			}
+			Dictionary icd = Dictionary(parsed).get("ICD", Dictionary());
+			String library = icd.get("library_path", String());
+			if (library.is_absolute_path() && stat(library.utf8().get_data(), &st) == 0) {
+				fingerprint += library + ":" + itos(st.st_mtime) + ";";
+			}
+		}
+	}
+	// Overrides replace the directory search altogether.
+	for (const char *var : icd_overrides) {
+		const char *value = getenv(var);
+		if (value) {
+			fingerprint += String(var) + "=" + String::utf8(value) + ";";
+		}
+	}
+	return fingerprint.is_empty() ? String("none") : String::num_uint64(fingerprint.hash(), 16);
+}
+
+void RendererProbeCacheSBC::load() {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	struct utsname name;
+	String kernel = uname(&name) == 0 ? String::utf8(name.release) : String("unknown");
+	const char *video_driver = SDL_GetCurrentVideoDriver();
+	key = kernel + "|" + String(video_driver ? video_driver : "none") + "|" + _gpu_id() + "|icd:" + _icd_id();
+
+	path = OS::get_singleton()->get_cache_path().path_join("godot_sbc").path_join("renderer_probe.cfg");
+	config.instantiate();
+	config->load(path); // A missing file just means nothing is known yet.
+	load_usec = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+bool RendererProbeCacheSBC::is_known_failing(const String &p_driver, uint64_t &r_usec) const {
+	if (config.is_null() || !config->has_section_key(key, p_driver + "_ok")) {
+		return false;
+	}
+	if (bool(config->get_value(key, p_driver + "_ok"))) {
+		return false;
+	}
+	int64_t probed = config->get_value(key, p_driver + "_time", 0);
+	if (Time::get_singleton()->get_unix_time_from_system() - probed > RETRY_DAYS * 86400) {
+		return false;
+	}
+	r_usec = int64_t(config->get_value(key, p_driver + "_usec", 0));
+	return true;
+}
+
+void RendererProbeCacheSBC::store(const String &p_driver, bool p_ok, uint64_t p_usec) {
+	if (config.is_null()) {
+		return;
+	}
+	config->set_value(key, p_driver + "_ok", p_ok);
+	config->set_value(key, p_driver + "_usec", int64_t(p_usec));
+	config->set_value(key, p_driver + "_time", int64_t(Time::get_singleton()->get_unix_time_from_system()));
+
+	DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+	if (config->save(path) != OK) {
+		print_verbose("Could not save the renderer probe cache to " + path);
+	}
+}
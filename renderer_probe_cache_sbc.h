@@ -0,0 +1,38 @@
+#ifndef RENDERER_PROBE_CACHE_SBC_H
+#define RENDERER_PROBE_CACHE_SBC_H
+
+#include "core/io/config_file.h"
+#include "core/string/ustring.h"
+
+// Remembers, per machine configuration, whether a rendering driver came up
+// last time, so boards whose Vulkan stack can't initialize stop paying for
+// the failed probe (seconds on some Mesa versions) on every launch. Entries
+// live in <cache>/godot_sbc/renderer_probe.cfg under a key made of the
+// kernel release, the SDL video driver, the GPU's DRM driver/modalias and a
+// fingerprint of the installed Vulkan ICDs (manifest names and mtimes, plus
+// the driver libraries they point to), so a kernel, hardware or Mesa update
+// probes again. Failures are also retried after RETRY_DAYS regardless.
+class RendererProbeCacheSBC {
+	static const int RETRY_DAYS = 30;
+
+	String path;
+	String key;
+	Ref<ConfigFile> config;
+	uint64_t load_usec = 0;
+
+	static String _read_first_line(const char *p_path);
+	static String _gpu_id();
+	static String _icd_id();
+
+public:
+	void load();
+	const String &get_key() const { return key; }
+	// What building the key and reading the cache cost, to weigh against a skipped probe.
+	uint64_t get_load_usec() const { return load_usec; }
+
+	// True when p_driver failed before on this configuration; r_usec is what that probe cost.
+	bool is_known_failing(const String &p_driver, uint64_t &r_usec) const;
+	void store(const String &p_driver, bool p_ok, uint64_t p_usec);
+};
+
+#endif // RENDERER_PROBE_CACHE_SBC_H
@@ -6,7 +6,15 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
 
+bool RenderingContextDriverVulkanSDL::is_headless() {
+	const char *driver = SDL_GetCurrentVideoDriver();
+	return driver && (!strcmp(driver, "offscreen") || !strcmp(driver, "dummy"));
+}
+
 const char *RenderingContextDriverVulkanSDL::_get_platform_surface_extension() const {
+	if (is_headless()) {
+		return VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME;
+	}
 	const char *driver = SDL_GetCurrentVideoDriver();
 	if (!driver) {
 		driver = "<null>";
@@ -29,7 +37,18 @@ RenderingContextDriver::SurfaceID RenderingContextDriverVulkanSDL::surface_creat
 	print_line("surface_create: wpd->window=" + itos((uintptr_t)(wpd->window)));
 	print_line("surface_create: instance=" + itos((uintptr_t)instance_get()));
 
-	if (!SDL_Vulkan_CreateSurface(wpd->window, instance_get(), &vk_surface)) {
+	if (is_headless()) {
+		PFN_vkCreateHeadlessSurfaceEXT create_headless_surface = (PFN_vkCreateHeadlessSurfaceEXT)vkGetInstanceProcAddr(instance_get(), "vkCreateHeadlessSurfaceEXT");
+		ERR_FAIL_NULL_V_MSG(create_headless_surface, 0, "VK_EXT_headless_surface is not available.");
+
+		VkHeadlessSurfaceCreateInfoEXT create_info = {};
+		create_info.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+		if (create_headless_surface(instance_get(), &create_info, nullptr, &vk_surface) != VK_SUCCESS) {
+			ERR_PRINT("Failed to create headless Vulkan surface.");
+			return 0;
+		}
+		print_line("surface_create: using VK_EXT_headless_surface");
+	} else if (!SDL_Vulkan_CreateSurface(wpd->window, instance_get(), &vk_surface)) {
 		String sdl_err = SDL_GetError();
 		ERR_PRINT("Failed to create Vulkan surface: " + sdl_err);
 		return 0;
@@ -41,6 +60,67 @@ RenderingContextDriver::SurfaceID RenderingContextDriverVulkanSDL::surface_creat
 	return SurfaceID(surface);
 }
 
+Vector<VkPresentModeKHR> RenderingContextDriverVulkanSDL::window_get_present_modes(DisplayServer::WindowID p_window) const {
+	Vector<VkPresentModeKHR> modes;
+	Surface *surface = (Surface *)(surface_get_from_window(p_window));
+	if (!surface) {
+		return modes;
+	}
+
+	for (uint32_t i = 0; i < device_get_count(); i++) {
+		VkPhysicalDevice physical_device = physical_device_get(i);
+		uint32_t count = 0;
+		if (vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface->vk_surface, &count, nullptr) != VK_SUCCESS || count == 0) {
+			continue;
+		}
+		modes.resize(count);
+		if (vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface->vk_surface, &count, modes.ptrw()) == VK_SUCCESS) {
+			modes.resize(count);
+			break; // SBCs have a single presenting GPU; the first one that answers is it.
+		}
+		modes.clear();
+	}
+	return modes;
+}
+
+static VkPresentModeKHR _vsync_to_present_mode(DisplayServer::VSyncMode p_mode) {
+	switch (p_mode) {
+		case DisplayServer::VSYNC_DISABLED:
+			return VK_PRESENT_MODE_IMMEDIATE_KHR;
+		case DisplayServer::VSYNC_ADAPTIVE:
+			return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+		case DisplayServer::VSYNC_MAILBOX:
+			return VK_PRESENT_MODE_MAILBOX_KHR;
+		default:
+			return VK_PRESENT_MODE_FIFO_KHR;
+	}
+}
+
+DisplayServer::VSyncMode RenderingContextDriverVulkanSDL::resolve_vsync_mode(DisplayServer::WindowID p_window, DisplayServer::VSyncMode p_requested) const {
+	Vector<VkPresentModeKHR> modes = window_get_present_modes(p_window);
+	if (modes.is_empty()) {
+		return p_requested; // Unknown, let the swapchain decide.
+	}
+
+	// Tearing modes fall back to each other before giving up latency to FIFO.
+	DisplayServer::VSyncMode chain[3] = { p_requested, DisplayServer::VSYNC_ENABLED, DisplayServer::VSYNC_ENABLED };
+	if (p_requested == DisplayServer::VSYNC_MAILBOX) {
+		chain[1] = DisplayServer::VSYNC_DISABLED;
+	} else if (p_requested == DisplayServer::VSYNC_DISABLED) {
+		chain[1] = DisplayServer::VSYNC_MAILBOX;
+	}
+
+	for (DisplayServer::VSyncMode mode : chain) {
+		if (modes.has(_vsync_to_present_mode(mode))) {
+			if (mode != p_requested) {
+				print_line(vformat("Vulkan: present mode for vsync mode %d not supported, using vsync mode %d.", p_requested, mode));
+			}
+			return mode;
+		}
+	}
+	return DisplayServer::VSYNC_ENABLED; // FIFO support is mandatory.
+}
+
 RenderingContextDriverVulkanSDL::RenderingContextDriverVulkanSDL() {
 	// Does nothing.
 }
@@ -26,6 +26,17 @@ public:
 		SDL_Window *window;
 	};
 
+	// SDL's offscreen and dummy video drivers have no window system to present
+	// to; surfaces then come from VK_EXT_headless_surface, which lavapipe
+	// supports, so the RD renderer can run on GPU-less machines.
+	static bool is_headless();
+
+	// Present modes the window's surface supports on any physical device, empty if unknown.
+	Vector<VkPresentModeKHR> window_get_present_modes(DisplayServer::WindowID p_window) const;
+	// Walks a fallback chain from the requested mode to one the surface supports,
+	// so the swapchain never silently drops to FIFO.
+	DisplayServer::VSyncMode resolve_vsync_mode(DisplayServer::WindowID p_window, DisplayServer::VSyncMode p_requested) const;
+
 	RenderingContextDriverVulkanSDL();
 	~RenderingContextDriverVulkanSDL();
 };
@@ -291,14 +291,50 @@ static inline Key sdl2godot_physical_keycode(SDL_Scancode scancode) {
 	return (Key)(GODOT_KEY_PHYSICAL_MASK | (unsigned int)scancode);
 }
 
-static inline int utf8_to_unicode(const char *s) {
-	if ((s[0] & 0x80) == 0) {
-		return s[0];
-	} else if ((s[0] & 0xe0) == 0xc0) {
-		return ((s[0] & 0x1f) << 6) | (s[1] & 0x3f);
-	} else if ((s[0] & 0xf0) == 0xe0) {
-		return ((s[0] & 0x0f) << 12) | ((s[1] & 0x3f) << 6) | (s[2] & 0x3f);
-	} else {
-		return 0;
+// Sequence length indexed by the top five bits of a UTF-8 lead byte. Continuation
+// bytes (0x80-0xBF) map to 0; the remaining invalid lead bytes (C0, C1, F5-FF) are
+// rejected by the range check in sdl_utf8_decode.
+static const uint8_t sdl_utf8_lead_length[32] = {
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x00-0x7F
+	0, 0, 0, 0, 0, 0, 0, 0, // 0x80-0xBF
+	2, 2, 2, 2, // 0xC0-0xDF
+	3, 3, // 0xE0-0xEF
+	4, 0, // 0xF0-0xF7, 0xF8-0xFF
+};
+
+static const uint32_t sdl_utf8_min_codepoint[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+// Decodes one codepoint from at most p_len bytes of p_str, without allocating.
+// Returns the number of bytes consumed (at least 1 while p_len > 0). Truncated,
+// overlong, surrogate or out-of-range sequences decode to U+FFFD and consume a
+// single byte, so the caller resynchronises on the next lead byte.
+static inline int sdl_utf8_decode(const char *p_str, int p_len, char32_t &r_codepoint) {
+	const uint8_t *s = (const uint8_t *)p_str;
+	const uint8_t lead = s[0];
+	if (lead < 0x80) {
+		// Barcode scanners and most keyboards type ASCII, keep it off the table load.
+		r_codepoint = lead;
+		return 1;
+	}
+
+	const int len = sdl_utf8_lead_length[lead >> 3];
+	if (len == 0 || len > p_len || lead > 0xf4) {
+		r_codepoint = 0xfffd;
+		return 1;
+	}
+
+	uint32_t cp = lead & (0x7f >> len);
+	uint8_t bad = 0;
+	for (int i = 1; i < len; i++) {
+		bad |= (s[i] & 0xc0) ^ 0x80;
+		cp = (cp << 6) | (s[i] & 0x3f);
+	}
+
+	if (bad || cp < sdl_utf8_min_codepoint[len] || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) {
+		r_codepoint = 0xfffd;
+		return 1;
 	}
-}
\ No newline at end of file
+
+	r_codepoint = cp;
+	return len;
+}
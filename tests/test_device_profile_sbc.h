@@ -0,0 +1,96 @@
+#ifndef TEST_DEVICE_PROFILE_SBC_H
+#define TEST_DEVICE_PROFILE_SBC_H
+
+#include "platform/sbc/device_profile_sbc.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestDeviceProfileSBC {
+
+// Each directory under tests/data/device_profile is a captured sysfs/procfs
+// tree; only the files DeviceProfileSBC reads are kept.
+static String fixture_root(const String &p_board) {
+	return TestUtils::get_executable_dir().path_join("../platform/sbc/tests/data/device_profile").path_join(p_board);
+}
+
+static DeviceProfileSBC::Profile probe_fixture(const String &p_board, const String &p_renderer, String &r_tier) {
+	OS::get_singleton()->set_environment("GODOT_SBC_SYSFS_ROOT", fixture_root(p_board));
+	DeviceProfileSBC device_profile;
+	DeviceProfileSBC::Profile profile = device_profile.probe(p_renderer);
+	r_tier = device_profile.select_tier(DeviceProfileSBC::get_default_tiers()).get("name", String());
+	OS::get_singleton()->unset_environment("GODOT_SBC_SYSFS_ROOT");
+	return profile;
+}
+
+TEST_CASE("[SBC][DeviceProfile] Default tiers from fixture trees") {
+	String tier;
+
+	DeviceProfileSBC::Profile profile = probe_fixture("rk3588", "Mali-G610", tier);
+	CHECK(profile.model == "Radxa ROCK 5 Model B");
+	CHECK(profile.cores == 8);
+	CHECK(profile.max_freq_mhz == 2400);
+	CHECK(profile.ram_mb == 15819);
+	CHECK(profile.renderer == "Mali-G610");
+	CHECK(tier == "high");
+
+	profile = probe_fixture("pi4_4gb", "V3D 4.2", tier);
+	CHECK(profile.cores == 4);
+	CHECK(profile.max_freq_mhz == 1800);
+	CHECK(tier == "medium");
+
+	// Same model string and renderer as above, only MemTotal differs.
+	profile = probe_fixture("pi4_1gb", "V3D 4.2", tier);
+	CHECK(profile.model == "Raspberry Pi 4 Model B Rev 1.4");
+	CHECK(profile.ram_mb == 922);
+	CHECK(tier == "low");
+
+	probe_fixture("pi3", "VC4 V3D 2.1", tier);
+	CHECK(tier == "low");
+}
+
+TEST_CASE("[SBC][DeviceProfile] Non-contiguous CPU IDs") {
+	// present is "0-1,4-5": the 2 GHz cores are cpu4 and cpu5.
+	String tier;
+	DeviceProfileSBC::Profile profile = probe_fixture("split_cpus", "Mali-G52", tier);
+	CHECK(profile.cores == 4);
+	CHECK(profile.max_freq_mhz == 2000);
+	CHECK(tier == "medium");
+}
+
+TEST_CASE("[SBC][DeviceProfile] Empty tree") {
+	String tier;
+	DeviceProfileSBC::Profile profile = probe_fixture("empty", "", tier);
+	CHECK(profile.model == "unknown");
+	CHECK(profile.cores == 0);
+	CHECK(profile.max_freq_mhz == 0);
+	CHECK(profile.ram_mb == 0);
+	CHECK(tier == "low");
+}
+
+TEST_CASE("[SBC][DeviceProfile] Model and renderer constraints") {
+	Array tiers;
+	Dictionary pi4;
+	pi4["name"] = "pi4";
+	pi4["model"] = "raspberry pi 4"; // Matched case-insensitively.
+	pi4["renderer"] = "V3D";
+	tiers.push_back(pi4);
+	Dictionary other;
+	other["name"] = "other";
+	tiers.push_back(other);
+
+	OS::get_singleton()->set_environment("GODOT_SBC_SYSFS_ROOT", fixture_root("pi4_1gb"));
+	DeviceProfileSBC device_profile;
+	device_profile.probe("V3D 4.2");
+	CHECK(String(device_profile.select_tier(tiers).get("name", String())) == "pi4");
+
+	DeviceProfileSBC llvmpipe;
+	llvmpipe.probe("llvmpipe (LLVM 15.0.6, 128 bits)");
+	CHECK(String(llvmpipe.select_tier(tiers).get("name", String())) == "other");
+	OS::get_singleton()->unset_environment("GODOT_SBC_SYSFS_ROOT");
+}
+
+} // namespace TestDeviceProfileSBC
+
+#endif // TEST_DEVICE_PROFILE_SBC_H
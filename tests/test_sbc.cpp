@@ -0,0 +1,3 @@
+// tests/SCsub only collects core and module tests; the platform's own are
+// compiled in from here when building with tests=yes.
+#include "test_device_profile_sbc.h"
@@ -0,0 +1,125 @@
+#include "touch_gesture_recognizer_sdl.h"
+
+#include "core/math/math_funcs.h"
+
+int TouchGestureRecognizerSDL::_find_slot(SDL_FingerID p_id) const {
+	for (int i = 0; i < MAX_TOUCHES; i++) {
+		if (fingers[i].active && fingers[i].id == p_id) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void TouchGestureRecognizerSDL::_measure(Vector2 &r_centroid, float &r_spread) const {
+	Vector2 sum;
+	for (int i = 0; i < MAX_TOUCHES; i++) {
+		if (fingers[i].active) {
+			sum += fingers[i].position;
+		}
+	}
+	r_centroid = sum / active_count;
+
+	float spread = 0.0f;
+	for (int i = 0; i < MAX_TOUCHES; i++) {
+		if (fingers[i].active) {
+			spread += fingers[i].position.distance_to(r_centroid);
+		}
+	}
+	r_spread = spread / active_count;
+}
+
+void TouchGestureRecognizerSDL::_reset_tracking() {
+	// Any change in finger count restarts the gesture from the current layout,
+	// so lifting or adding a finger never shows up as a jump.
+	tracking = active_count >= 2;
+	magnify_latched = false;
+	pan_latched = false;
+	if (tracking) {
+		_measure(last_centroid, last_spread);
+		start_centroid = last_centroid;
+		start_spread = last_spread;
+	}
+}
+
+void TouchGestureRecognizerSDL::set_thresholds(float p_magnify, float p_pan) {
+	magnify_threshold = MAX(p_magnify, 0.0f);
+	pan_threshold = MAX(p_pan, 0.0f);
+}
+
+int TouchGestureRecognizerSDL::touch_down(SDL_FingerID p_id, const Vector2 &p_position) {
+	int slot = _find_slot(p_id);
+	if (slot < 0) {
+		for (int i = 0; i < MAX_TOUCHES; i++) {
+			if (!fingers[i].active) {
+				slot = i;
+				break;
+			}
+		}
+		if (slot < 0) {
+			return -1; // Out of slots, ignore extra fingers.
+		}
+		fingers[slot].id = p_id;
+		fingers[slot].active = true;
+		active_count++;
+	}
+	fingers[slot].position = p_position;
+	_reset_tracking();
+	return slot;
+}
+
+int TouchGestureRecognizerSDL::touch_up(SDL_FingerID p_id) {
+	int slot = _find_slot(p_id);
+	if (slot < 0) {
+		return -1;
+	}
+	fingers[slot].active = false;
+	active_count--;
+	_reset_tracking();
+	return slot;
+}
+
+int TouchGestureRecognizerSDL::touch_move(SDL_FingerID p_id, const Vector2 &p_position) {
+	int slot = _find_slot(p_id);
+	if (slot < 0) {
+		return -1;
+	}
+	fingers[slot].position = p_position;
+	dirty = true;
+	return slot;
+}
+
+bool TouchGestureRecognizerSDL::flush(Gesture &r_gesture) {
+	if (!dirty || !tracking) {
+		dirty = false;
+		return false;
+	}
+	dirty = false;
+
+	Vector2 centroid;
+	float spread;
+	_measure(centroid, spread);
+
+	if (!magnify_latched && start_spread > 0.0f && Math::abs(spread / start_spread - 1.0f) >= magnify_threshold) {
+		magnify_latched = true;
+	}
+	if (!pan_latched && centroid.distance_to(start_centroid) >= pan_threshold) {
+		pan_latched = true;
+	}
+
+	r_gesture.center = centroid;
+	r_gesture.magnify = magnify_latched && last_spread > 0.0f && spread != last_spread;
+	r_gesture.magnify_factor = r_gesture.magnify ? spread / last_spread : 1.0f;
+	r_gesture.pan = pan_latched && centroid != last_centroid;
+	r_gesture.pan_delta = r_gesture.pan ? centroid - last_centroid : Vector2();
+
+	// Keep accumulating below the thresholds so slow gestures still latch.
+	if (magnify_latched) {
+		last_spread = spread;
+	}
+	if (pan_latched) {
+		last_centroid = centroid;
+	}
+
+	return r_gesture.magnify || r_gesture.pan;
+}
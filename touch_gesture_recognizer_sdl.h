@@ -0,0 +1,65 @@
+#ifndef TOUCH_GESTURE_RECOGNIZER_SDL_H
+#define TOUCH_GESTURE_RECOGNIZER_SDL_H
+
+#include "core/math/vector2.h"
+#include <SDL2/SDL.h>
+
+// Tracks active SDL fingers in a fixed slot array and turns two-or-more finger
+// motion into pinch (magnify) and pan deltas, once per processed event batch.
+// Slot indices double as the Godot touch index, since SDL finger IDs are not
+// small or contiguous.
+class TouchGestureRecognizerSDL {
+public:
+	static const int MAX_TOUCHES = 10;
+
+	struct Gesture {
+		Vector2 center;
+		float magnify_factor = 1.0f; // Relative to the previous flush.
+		Vector2 pan_delta; // Centroid motion in window pixels.
+		bool magnify = false;
+		bool pan = false;
+	};
+
+private:
+	struct Finger {
+		SDL_FingerID id = 0;
+		Vector2 position;
+		bool active = false;
+	};
+
+	Finger fingers[MAX_TOUCHES];
+	int active_count = 0;
+	bool dirty = false;
+
+	// Reference state of the current multi-finger gesture.
+	bool tracking = false;
+	Vector2 last_centroid;
+	float last_spread = 0.0f;
+	Vector2 start_centroid;
+	float start_spread = 0.0f;
+	bool magnify_latched = false;
+	bool pan_latched = false;
+
+	float magnify_threshold = 0.05f;
+	float pan_threshold = 8.0f;
+
+	int _find_slot(SDL_FingerID p_id) const;
+	void _measure(Vector2 &r_centroid, float &r_spread) const;
+	void _reset_tracking();
+
+public:
+	void set_thresholds(float p_magnify, float p_pan);
+
+	// Each returns the slot used for the finger, or -1 when it is not tracked.
+	int touch_down(SDL_FingerID p_id, const Vector2 &p_position);
+	int touch_up(SDL_FingerID p_id);
+	int touch_move(SDL_FingerID p_id, const Vector2 &p_position);
+
+	// True once a pinch or pan has passed its threshold, not merely with two fingers down.
+	bool is_gesture_active() const { return tracking && (magnify_latched || pan_latched); }
+
+	// Call once after the event batch; returns true if r_gesture holds a delta.
+	bool flush(Gesture &r_gesture);
+};
+
+#endif // TOUCH_GESTURE_RECOGNIZER_SDL_H